@@ -0,0 +1,210 @@
+/**
+ * Benchmark of the library on the target, results as CSV over USB-CDC.
+ *
+ * Columns (stable, append new ones at the end only):
+ *   schema     - format version of this output, "ssd1306-bench-1"
+ *   platform   - rp2040 or rp2350
+ *   sys_khz    - system clock
+ *   display    - panel size
+ *   test       - operation name
+ *   i2c_khz    - I2C clock for bus tests, 0 for framebuffer-only tests
+ *   iterations - operations timed
+ *   us_per_op  - mean time per operation in microseconds
+ *   ops_per_s  - operations per second (frames per second for fps_* tests)
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "hardware/i2c.h"
+#include "hardware/clocks.h"
+
+#include "ssd1306.h"
+#include "ssd1306_sprite.h"
+#include "raspberry_pi_logo.h"
+#include "google_sans_code_32.h"
+
+#define SSD1306_I2C_ADDRESS 0x3C
+
+#define I2C_PORT i2c0
+#define I2C_SDA 16
+#define I2C_SCL 17
+
+#define BENCHMARK_SCHEMA "ssd1306-bench-1"
+#define BENCHMARK_CPU_ITERATIONS 200
+#define BENCHMARK_BUS_ITERATIONS 20
+#define BENCHMARK_FPS_DURATION_US 2000000
+#define BENCHMARK_REPEAT_MS 10000
+
+#if PICO_RP2350
+#define BENCHMARK_PLATFORM "rp2350"
+#else
+#define BENCHMARK_PLATFORM "rp2040"
+#endif
+
+static ssd1306_t ssd1306;
+
+static void report(const char* test, uint32_t i2c_khz, uint32_t iterations, uint64_t elapsed_us) {
+    const double us_per_op = (double)elapsed_us / iterations;
+    printf("%s,%s,%lu,%ux%u,%s,%lu,%lu,%.2f,%.1f\n", BENCHMARK_SCHEMA, BENCHMARK_PLATFORM,
+           (unsigned long)(clock_get_hz(clk_sys) / 1000), ssd1306.width, ssd1306.height, test,
+           (unsigned long)i2c_khz, (unsigned long)iterations, us_per_op, us_per_op > 0 ? 1e6 / us_per_op : 0.0);
+}
+
+// Runs `op` `iterations` times and reports the mean.
+#define BENCHMARK(test, i2c_khz, iterations, op) \
+    do { \
+        const uint64_t begin = time_us_64(); \
+        for (uint32_t i = 0; i < (iterations); i++) { \
+            op; \
+        } \
+        report((test), (i2c_khz), (iterations), time_us_64() - begin); \
+    } while (0)
+
+// Page-native and compressed copies of the logo, converted once at startup.
+static uint8_t logo_pages_data[128 * 64 / 8];
+static uint8_t logo_rle_data[128 * 64 / 8 * 2];
+
+static void convert_logo(bitmap_t* pages, bitmap_t* rle) {
+    const uint8_t width = raspberry_pi_logo.width;
+    const uint8_t height = raspberry_pi_logo.height;
+    const uint8_t row_bytes = (width + 7) / 8;
+    memset(logo_pages_data, 0, sizeof(logo_pages_data));
+    for (uint8_t y = 0; y < height; y++) {
+        for (uint8_t x = 0; x < width; x++) {
+            if (raspberry_pi_logo.data[y * row_bytes + x / 8] & (1u << (x % 8))) {
+                logo_pages_data[(y / 8) * width + x] |= (uint8_t)(1u << (y % 8));
+            }
+        }
+    }
+
+    // PackBits, the same encoding as tools/assets/ssd1306_assets.py --rle
+    const uint16_t size = (uint16_t)(width * ((height + 7) / 8));
+    uint16_t in = 0;
+    uint16_t out = 0;
+    while (in < size) {
+        uint16_t run = 1;
+        while (in + run < size && run < 128 && logo_pages_data[in + run] == logo_pages_data[in]) {
+            run++;
+        }
+        if (run >= 2) {
+            logo_rle_data[out++] = (uint8_t)(257 - run);
+            logo_rle_data[out++] = logo_pages_data[in];
+            in += run;
+            continue;
+        }
+        uint16_t end = in;
+        while (end < size && end - in < 128 && !(end + 1 < size && logo_pages_data[end] == logo_pages_data[end + 1])) {
+            end++;
+        }
+        logo_rle_data[out++] = (uint8_t)(end - in - 1);
+        memcpy(&logo_rle_data[out], &logo_pages_data[in], end - in);
+        out += end - in;
+        in = end;
+    }
+
+    *pages = (bitmap_t){ .width = width, .height = height, .data = logo_pages_data, .format = BITMAP_FORMAT_PAGES };
+    *rle = (bitmap_t){ .width = width, .height = height, .data = logo_rle_data, .format = BITMAP_FORMAT_PAGES_RLE };
+}
+
+static void benchmark_framebuffer(const bitmap_t* logo_pages, const bitmap_t* logo_rle) {
+    BENCHMARK("clear", 0, BENCHMARK_CPU_ITERATIONS, ssd1306_clear_display(&ssd1306));
+    BENCHMARK("bitmap_full_rows", 0, BENCHMARK_CPU_ITERATIONS, ssd1306_draw_bitmap(&ssd1306, &raspberry_pi_logo, 0, 0));
+    BENCHMARK("bitmap_full_pages", 0, BENCHMARK_CPU_ITERATIONS, ssd1306_draw_bitmap(&ssd1306, logo_pages, 0, 0));
+    BENCHMARK("bitmap_full_pages_unaligned", 0, BENCHMARK_CPU_ITERATIONS, ssd1306_draw_bitmap(&ssd1306, logo_pages, 0, 3));
+    BENCHMARK("bitmap_full_rle", 0, BENCHMARK_CPU_ITERATIONS, ssd1306_draw_bitmap(&ssd1306, logo_rle, 0, 0));
+    BENCHMARK("text_aligned", 0, BENCHMARK_CPU_ITERATIONS, ssd1306_print(&ssd1306, "128x64", 10, 16));
+    BENCHMARK("text_unaligned", 0, BENCHMARK_CPU_ITERATIONS, ssd1306_print(&ssd1306, "128x64", 10, 13));
+
+    static uint8_t gray[128 * 64];
+    for (uint16_t i = 0; i < sizeof(gray); i++) {
+        gray[i] = (uint8_t)((i % 128) * 2);
+    }
+    BENCHMARK("gray_bayer", 0, BENCHMARK_CPU_ITERATIONS,
+              ssd1306_draw_gray(&ssd1306, gray, 128, ssd1306.width, ssd1306.height, 0, 0, SSD1306_DITHER_BAYER));
+    BENCHMARK("gray_floyd_steinberg", 0, BENCHMARK_CPU_ITERATIONS,
+              ssd1306_draw_gray(&ssd1306, gray, 128, ssd1306.width, ssd1306.height, 0, 0, SSD1306_DITHER_FLOYD_STEINBERG));
+    BENCHMARK("gray_atkinson", 0, BENCHMARK_CPU_ITERATIONS,
+              ssd1306_draw_gray(&ssd1306, gray, 128, ssd1306.width, ssd1306.height, 0, 0, SSD1306_DITHER_ATKINSON));
+
+    static const uint8_t ball_data[] = { 0x3C, 0x42, 0x81, 0x81, 0x81, 0x81, 0x42, 0x3C };
+    static const uint8_t ball_mask[] = { 0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C };
+    const bitmap_t ball = { .width = 8, .height = 8, .data = ball_data };
+    ssd1306_sprite_layer_t layer = ssd1306_sprite_layer_create(&ssd1306, NULL);
+    ssd1306_sprite_t sprite = ssd1306_sprite_create(&ball, ball_mask, 0, 0, 0);
+    ssd1306_sprite_layer_add(&layer, &sprite);
+    BENCHMARK("sprite_move", 0, BENCHMARK_CPU_ITERATIONS, {
+        sprite.x = (int16_t)(i % 120);
+        sprite.y = (int16_t)(i % 56);
+        ssd1306_sprite_layer_compose(&layer);
+    });
+    ssd1306_sprite_layer_remove(&layer, &sprite);
+}
+
+static void benchmark_bus(uint32_t i2c_hz) {
+    const uint baudrate = i2c_set_baudrate(I2C_PORT, i2c_hz);
+    ssd1306_set_i2c_baudrate(&ssd1306, baudrate);
+    const uint32_t i2c_khz = i2c_hz / 1000;
+
+    ssd1306_clear_display(&ssd1306);
+    ssd1306_draw_bitmap(&ssd1306, &raspberry_pi_logo, 0, 0);
+    BENCHMARK("show_full", i2c_khz, BENCHMARK_BUS_ITERATIONS, {
+        ssd1306_mark_dirty(&ssd1306, 0, 0, ssd1306.width, ssd1306.height);
+        ssd1306_show(&ssd1306);
+    });
+    BENCHMARK("show_8x8", i2c_khz, BENCHMARK_BUS_ITERATIONS, {
+        ssd1306_mark_dirty(&ssd1306, 60, 24, 8, 8);
+        ssd1306_show(&ssd1306);
+    });
+
+    // Sustained rate of a changing full-screen picture: redraw, flush, repeat.
+    uint32_t frames = 0;
+    const uint64_t begin = time_us_64();
+    uint64_t elapsed = 0;
+    while (elapsed < BENCHMARK_FPS_DURATION_US) {
+        ssd1306_clear_display(&ssd1306);
+        ssd1306_draw_bitmap(&ssd1306, &raspberry_pi_logo, (uint8_t)(frames % 8), 0);
+        ssd1306_show(&ssd1306);
+        frames++;
+        elapsed = time_us_64() - begin;
+    }
+    report("fps_full", i2c_khz, frames, elapsed);
+}
+
+int main() {
+    stdio_init_all();
+
+    i2c_init(I2C_PORT, 400*1000);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+
+    ssd1306 = ssd1306_create(I2C_PORT, SSD1306_I2C_ADDRESS, SSD1306_DISPLAY_SIZE_128x64);
+    ssd1306_config_t ssd1306_cfg = ssd1306_get_default_config();
+    const bool is_display_ok = ssd1306_init(&ssd1306, &ssd1306_cfg);
+    ssd1306_set_font(&ssd1306, &google_sans_code_32);
+
+    bitmap_t logo_pages;
+    bitmap_t logo_rle;
+    convert_logo(&logo_pages, &logo_rle);
+
+    while (!stdio_usb_connected()) {
+        sleep_ms(100);
+    }
+
+    while (true) {
+        printf("schema,platform,sys_khz,display,test,i2c_khz,iterations,us_per_op,ops_per_s\n");
+        benchmark_framebuffer(&logo_pages, &logo_rle);
+        if (is_display_ok) {
+            benchmark_bus(100 * 1000);
+            benchmark_bus(400 * 1000);
+            benchmark_bus(1000 * 1000);
+        } else {
+            printf("# SSD1306 not found, bus tests skipped\n");
+        }
+        printf("\n");
+        sleep_ms(BENCHMARK_REPEAT_MS);
+    }
+}
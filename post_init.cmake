@@ -5,5 +5,8 @@ target_compile_definitions(pico_ssd1306_included INTERFACE
 
 pico_add_platform_library(pico_ssd1306_included)
 
+# ssd1306_add_assets(): build-time conversion of fonts and images
+include(${CMAKE_CURRENT_LIST_DIR}/tools/assets/ssd1306_assets.cmake)
+
 # note as we're a .cmake included by the SDK, we're relative to the pico-sdk build
 add_subdirectory(${CMAKE_CURRENT_LIST_DIR}/src ${CMAKE_BINARY_DIR}/pico_ssd1306/src)
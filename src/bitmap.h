@@ -9,10 +9,32 @@
 
 #include <stdint.h>
 
+typedef enum {
+    BITMAP_FORMAT_ROWS = 0x00, // Rows of ceil(width / 8) bytes, LSB = leftmost pixel (bitmap_editor, font2bitmap)
+    BITMAP_FORMAT_PAGES = 0x01, // Page-native: for each 8-row page, one byte per column, LSB = top row
+    BITMAP_FORMAT_PAGES_RLE = 0x02, // BITMAP_FORMAT_PAGES compressed with PackBits
+} bitmap_format_t;
+
 typedef struct {
     uint8_t width;
     uint8_t height;
     const uint8_t* data;
+    uint8_t format; // bitmap_format_t, BITMAP_FORMAT_ROWS when not set
 } bitmap_t;
 
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t width;
+    uint8_t height;
+} bitmap_rect_t;
+
+// Many icons packed into one sheet, drawn with ssd1306_draw_atlas()
+typedef struct {
+    bitmap_t sheet;
+    const uint8_t* mask; // Optional, layout of sheet.data: 1 = opaque, 0 = transparent
+    uint16_t rects_count;
+    const bitmap_rect_t* rects; // Source rectangle of each icon in the sheet
+} bitmap_atlas_t;
+
 #endif // BITMAP_H
@@ -8,14 +8,16 @@
 #define FONT_H
 
 #include <stdint.h>
+#include "bitmap.h"
 
 typedef struct {
-    uint16_t start;
-    uint16_t end;
+    uint32_t start;
+    uint32_t end;
     uint16_t symbols_count;
     const uint8_t* symbols;
-    const uint32_t* offsets;
+    const uint32_t* offsets; // Start of each glyph in symbols
     const uint8_t* widths; // NULL for monospaced fonts
+    const uint32_t* codepoints; // Sparse subset: sorted codepoints of its glyphs. NULL when every codepoint in start..end has a glyph
 } font_subset_t;
 
 typedef struct {
@@ -25,6 +27,7 @@ typedef struct {
     uint8_t word_spacing;
     uint16_t subsets_count;
     const font_subset_t* subsets;
+    uint8_t format; // bitmap_format_t of all glyphs, BITMAP_FORMAT_ROWS when not set
 } font_t;
 
 #endif // FONT_H
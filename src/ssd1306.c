@@ -8,16 +8,165 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include "pico/time.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
 #include "ssd1306_def.h"
 #include "ssd1306.h"
-
-// Maximum bytes in the SSD1306 init command sequence, including leading control byte.
-#define SSD1306_INIT_COMMANDS_CAPACITY 30
+#include "ssd1306_internal.h"
+
+// Maximum bytes in the SSD1306 init command sequence, including leading control byte and the controller's own commands.
+#define SSD1306_INIT_COMMANDS_CAPACITY (30 + SSD1306_CONTROLLER_INIT_COMMANDS_MAX)
+// Maximum settings (commands with optional value) between display OFF and display ON in the init sequence.
+#define SSD1306_INIT_SETTINGS_CAPACITY 18
+
+#if SSD1306_ENABLE_STATS
+#define SSD1306_STATS_TIME_BEGIN(name) const uint32_t name = time_us_32()
+#define SSD1306_STATS_TIME_END(ssd1306, timing, begin) \
+    do { if ((ssd1306) != NULL) ssd1306_stats_record_timing(&(ssd1306)->stats.timing, time_us_32() - (begin)); } while (0)
+#else
+#define SSD1306_STATS_TIME_BEGIN(name) ((void)0)
+#define SSD1306_STATS_TIME_END(ssd1306, timing, begin) ((void)0)
+#endif
 
 static bool i2c_write_exact(int result, size_t expected_len) {
     return result == (int)expected_len;
 }
 
+#if SSD1306_ENABLE_STATS
+static void ssd1306_stats_record_timing(ssd1306_timing_t* timing, uint32_t elapsed_us) {
+    timing->calls++;
+    timing->total_us += elapsed_us;
+    if (elapsed_us > timing->max_us) {
+        timing->max_us = elapsed_us;
+    }
+}
+
+static void ssd1306_stats_record_write(ssd1306_stats_t* stats, const uint8_t* data, size_t len, int result) {
+    const uint32_t sent = result > 0 ? (uint32_t)result : 0;
+    // Single commands (Co = 1) in front of the last control byte count as command bytes.
+    uint32_t prefix = 0;
+    while (prefix + 2 < len && data[prefix] == SSD1306_SEND_COMMAND_SINGLE) {
+        prefix += 2;
+    }
+    if (data[prefix] == SSD1306_SEND_DATA) {
+        stats->data_transactions++;
+        stats->data_bytes += sent > prefix ? sent - prefix : 0;
+        stats->command_bytes += sent > prefix ? prefix : sent;
+    } else {
+        stats->command_transactions++;
+        stats->command_bytes += sent;
+    }
+
+    if (result == PICO_ERROR_TIMEOUT) {
+        stats->i2c_timeouts++;
+    } else if (result < 0) {
+        stats->i2c_naks++;
+    } else if ((size_t)result != len) {
+        stats->i2c_short_writes++;
+    }
+}
+
+static void ssd1306_stats_record_flush(ssd1306_stats_t* stats, uint32_t elapsed_us) {
+    uint8_t bucket = 0;
+    while (bucket < SSD1306_STATS_HISTOGRAM_BUCKETS - 1 && (elapsed_us >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+    stats->flush_latency_histogram[bucket]++;
+    stats->frames_flushed++;
+}
+
+const ssd1306_stats_t* ssd1306_get_stats(const ssd1306_t* ssd1306) {
+    return ssd1306 == NULL ? NULL : &ssd1306->stats;
+}
+
+void ssd1306_reset_stats(ssd1306_t* ssd1306) {
+    if (ssd1306 == NULL) {
+        return;
+    }
+    memset(&ssd1306->stats, 0, sizeof(ssd1306->stats));
+}
+#endif
+
+/**
+ * Deadline for one transfer: twice the wire time at the configured baud rate
+ * (9 clocks per byte including ACK, plus the address byte) and a fixed slack.
+*/
+static uint32_t ssd1306_get_transfer_timeout_us(const ssd1306_t* ssd1306, size_t len) {
+    if (ssd1306->i2c_baudrate == 0) {
+        return SSD1306_I2C_TIMEOUT_US;
+    }
+    const uint64_t bits = ((uint64_t)len + 1) * 9;
+    return (uint32_t)((bits * 2000000u) / ssd1306->i2c_baudrate) + SSD1306_I2C_TIMEOUT_SLACK_US;
+}
+
+// Transfers of one flush, recorded while attached to a display as [length, 2 bytes LE][bytes] entries
+typedef struct ssd1306_transfer_log {
+    uint8_t* data;
+    uint16_t capacity;
+    uint16_t size;
+    bool is_full; // A transfer did not fit, so the recording is incomplete
+} ssd1306_transfer_log_t;
+
+static void ssd1306_transfer_log_append(ssd1306_transfer_log_t* log, const uint8_t* data, size_t len) {
+    if (log->is_full || (size_t)log->size + 2 + len > log->capacity) {
+        log->is_full = true;
+        return;
+    }
+    log->data[log->size] = (uint8_t)len;
+    log->data[log->size + 1] = (uint8_t)(len >> 8);
+    memcpy(log->data + log->size + 2, data, len);
+    log->size = (uint16_t)(log->size + 2 + len);
+}
+
+/**
+ * Account for the result of a transfer: stats and the consecutive NAK count.
+ * @return true if every byte was sent
+*/
+static bool ssd1306_i2c_record_result(ssd1306_t* ssd1306, const uint8_t* data, size_t len, int result) {
+#if SSD1306_ENABLE_STATS
+    ssd1306_stats_record_write(&ssd1306->stats, data, len, result);
+#else
+    (void)data;
+#endif
+    if (result == PICO_ERROR_GENERIC) {
+        if (ssd1306->consecutive_naks < UINT8_MAX) {
+            ssd1306->consecutive_naks++;
+        }
+    } else if (ssd1306->consecutive_naks < SSD1306_NAK_STORM_THRESHOLD) {
+        // After a NAK storm the count stays until the controller is initialized again: a reset
+        // controller acknowledges writes, but it has lost its settings.
+        ssd1306->consecutive_naks = 0;
+    }
+    return i2c_write_exact(result, len);
+}
+
+/**
+ * Write one I2C transfer. The first byte is a control byte: SSD1306_SEND_COMMAND, SSD1306_SEND_DATA,
+ * or SSD1306_SEND_COMMAND_SINGLE pairs in front of one of them.
+ * While a transfer log is attached the transfer is only recorded and counts as sent.
+*/
+static bool ssd1306_i2c_write(ssd1306_t* ssd1306, const uint8_t* data, size_t len) {
+    if (ssd1306->transfer_log != NULL) {
+        ssd1306_transfer_log_append(ssd1306->transfer_log, data, len);
+        return true;
+    }
+    const int result = i2c_write_timeout_us(ssd1306->i2c_inst, ssd1306->i2c_address, data, len, false, ssd1306_get_transfer_timeout_us(ssd1306, len));
+    return ssd1306_i2c_record_result(ssd1306, data, len, result);
+}
+
+/**
+ * Set the I2C baud rate the bus runs at (the value returned by i2c_init()).
+ * Transfers then time out after twice their wire time instead of SSD1306_I2C_TIMEOUT_US.
+ * @param baudrate Hz, 0 restores the fixed timeout
+*/
+void ssd1306_set_i2c_baudrate(ssd1306_t* ssd1306, uint32_t baudrate) {
+    if (ssd1306 == NULL) {
+        return;
+    }
+    ssd1306->i2c_baudrate = baudrate;
+}
+
 static uint16_t ssd1306_get_display_bytes(const ssd1306_t* ssd1306) {
     return (uint16_t)(((uint16_t)ssd1306->width * (uint16_t)ssd1306->height) / SSD1306_BITS_IN_BYTE);
 }
@@ -30,16 +179,365 @@ static bool ssd1306_is_ready(const ssd1306_t* ssd1306) {
     return ssd1306_has_valid_geometry(ssd1306) && ssd1306->buffer != NULL && ssd1306->buffer_size > 1;
 }
 
-static bool ssd1306_send_command(ssd1306_t* ssd1306, uint8_t command) {
-    return i2c_write_exact(i2c_write_timeout_us(ssd1306->i2c_inst, ssd1306->i2c_address, (uint8_t[]){SSD1306_SEND_COMMAND, command}, 2, false, SSD1306_I2C_TIMEOUT_US), 2);
+/**
+ * Copy of a font, bitmap or atlas pinned in the attached arena, or the asset itself
+*/
+static const void* ssd1306_resolve_resident(const ssd1306_t* ssd1306, const void* asset) {
+    return ssd1306->resident_arena != NULL ? _ssd1306_resident_find(ssd1306->resident_arena, asset) : asset;
+}
+
+static bool ssd1306_is_rotation_portrait(ssd1306_rotation_t rotation) {
+    return rotation == SSD1306_ROTATION_90 || rotation == SSD1306_ROTATION_270;
+}
+
+static bool ssd1306_is_portrait(const ssd1306_t* ssd1306) {
+    return ssd1306_is_rotation_portrait(ssd1306->rotation);
+}
+
+// Geometry of the panel, which differs from the framebuffer when rotated by 90 or 270 degrees.
+static uint8_t ssd1306_get_panel_width(const ssd1306_t* ssd1306) {
+    return ssd1306_is_portrait(ssd1306) ? ssd1306->height : ssd1306->width;
+}
+
+static uint8_t ssd1306_get_panel_height(const ssd1306_t* ssd1306) {
+    return ssd1306_is_portrait(ssd1306) ? ssd1306->width : ssd1306->height;
+}
+
+/**
+ * Extend the dirty column range of every page touched by the area.
+ * Area must already be clipped to the display.
+*/
+void _ssd1306_mark_dirty_area(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint16_t width, uint16_t height) {
+    uint8_t first_page = y / SSD1306_BITS_PER_COLUMN;
+    uint8_t last_page = (uint8_t)((y + height - 1) / SSD1306_BITS_PER_COLUMN);
+    uint8_t end_column = (uint8_t)(x + width);
+
+    if (ssd1306_is_portrait(ssd1306)) {
+        // Framebuffer columns are panel rows: mark the 8x8 blocks ssd1306_show() transposes.
+        first_page = x / SSD1306_BITS_PER_COLUMN;
+        last_page = (uint8_t)((x + width - 1) / SSD1306_BITS_PER_COLUMN);
+        end_column = (uint8_t)(((y + height - 1) / SSD1306_BITS_PER_COLUMN + 1) * SSD1306_BITS_PER_COLUMN);
+        x = y - y % SSD1306_BITS_PER_COLUMN;
+    }
+
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        if (ssd1306->dirty_end[page] == 0) {
+            ssd1306->dirty_start[page] = x;
+            ssd1306->dirty_end[page] = end_column;
+            continue;
+        }
+        if (x < ssd1306->dirty_start[page]) {
+            ssd1306->dirty_start[page] = x;
+        }
+        if (end_column > ssd1306->dirty_end[page]) {
+            ssd1306->dirty_end[page] = end_column;
+        }
+    }
+}
+
+static void ssd1306_mark_all_dirty(ssd1306_t* ssd1306) {
+    _ssd1306_mark_dirty_area(ssd1306, 0, 0, ssd1306->width, ssd1306->height);
+}
+
+/**
+ * Mark a framebuffer area as changed, e.g. after writing to ssd1306->buffer directly.
+ * The area is clipped to the display.
+*/
+void ssd1306_mark_dirty(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    if (!ssd1306_is_ready(ssd1306) || x >= ssd1306->width || y >= ssd1306->height || width == 0 || height == 0) {
+        return;
+    }
+    const uint16_t clipped_width = ((uint16_t)x + width > ssd1306->width) ? (ssd1306->width - x) : width;
+    const uint16_t clipped_height = ((uint16_t)y + height > ssd1306->height) ? (ssd1306->height - y) : height;
+    _ssd1306_mark_dirty_area(ssd1306, x, y, clipped_width, clipped_height);
+}
+
+/**
+ * Page-aligned area covering a rectangle, clipped to the display
+ * @return false if nothing of the rectangle is on the display
+*/
+static bool ssd1306_region_pages(const ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t* columns, uint8_t* first_page, uint8_t* pages) {
+    if (x >= ssd1306->width || y >= ssd1306->height || width == 0 || height == 0) {
+        return false;
+    }
+    const uint16_t x1 = (uint16_t)x + width < ssd1306->width ? (uint16_t)x + width : ssd1306->width;
+    const uint16_t y1 = (uint16_t)y + height < ssd1306->height ? (uint16_t)y + height : ssd1306->height;
+    *columns = (uint8_t)(x1 - x);
+    *first_page = y / SSD1306_BITS_PER_COLUMN;
+    *pages = (uint8_t)((y1 + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN - *first_page);
+    return true;
+}
+
+/**
+ * Copy a framebuffer area, e.g. before a popup covers it. Rows are extended to whole pages,
+ * so the saved data takes columns * pages bytes; SSD1306_REGION_SIZE() gives the worst case.
+ * The area is clipped to the display, the clip rectangle does not apply.
+ * @param ssd1306
+ * @param x
+ * @param y
+ * @param width
+ * @param height
+ * @param data Receives the area page by page
+ * @param size Bytes available in data
+ * @return false if data is too small or there is no full framebuffer (streaming mode)
+*/
+bool ssd1306_save_region(const ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t* data, size_t size) {
+    if (!ssd1306_is_ready(ssd1306) || ssd1306->display_list != NULL || data == NULL) {
+        return false;
+    }
+    uint8_t columns, first_page, pages;
+    if (!ssd1306_region_pages(ssd1306, x, y, width, height, &columns, &first_page, &pages)) {
+        return true;
+    }
+    if ((size_t)columns * pages > size) {
+        return false;
+    }
+    const uint8_t* source = ssd1306->buffer + 1 + (uint16_t)first_page * ssd1306->width + x;
+    for (uint8_t page = 0; page < pages; page++) {
+        memcpy(data, source, columns);
+        data += columns;
+        source += ssd1306->width;
+    }
+    return true;
+}
+
+/**
+ * Put back an area saved by ssd1306_save_region() with the same rectangle and mark it dirty,
+ * so the next ssd1306_show() sends only that area.
+ * @return false if there is no full framebuffer (streaming mode)
+*/
+bool ssd1306_restore_region(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t* data) {
+    if (!ssd1306_is_ready(ssd1306) || ssd1306->display_list != NULL || data == NULL) {
+        return false;
+    }
+    uint8_t columns, first_page, pages;
+    if (!ssd1306_region_pages(ssd1306, x, y, width, height, &columns, &first_page, &pages)) {
+        return true;
+    }
+    uint8_t* destination = ssd1306->buffer + 1 + (uint16_t)first_page * ssd1306->width + x;
+    for (uint8_t page = 0; page < pages; page++) {
+        memcpy(destination, data, columns);
+        data += columns;
+        destination += ssd1306->width;
+    }
+    _ssd1306_mark_dirty_area(ssd1306, x, first_page * SSD1306_BITS_PER_COLUMN, columns, (uint16_t)pages * SSD1306_BITS_PER_COLUMN);
+    return true;
+}
+
+/**
+ * Limit all drawing to a rectangle. The rectangle is clipped to the display.
+*/
+void ssd1306_set_clip(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    if (!ssd1306_has_valid_geometry(ssd1306)) {
+        return;
+    }
+    const uint16_t x1 = (uint16_t)x + width;
+    const uint16_t y1 = (uint16_t)y + height;
+    ssd1306->clip_x0 = x < ssd1306->width ? x : ssd1306->width;
+    ssd1306->clip_y0 = y < ssd1306->height ? y : ssd1306->height;
+    ssd1306->clip_x1 = (uint8_t)(x1 < ssd1306->width ? x1 : ssd1306->width);
+    ssd1306->clip_y1 = (uint8_t)(y1 < ssd1306->height ? y1 : ssd1306->height);
+}
+
+/**
+ * Allow drawing on the whole display again
+*/
+void ssd1306_reset_clip(ssd1306_t* ssd1306) {
+    if (!ssd1306_has_valid_geometry(ssd1306)) {
+        return;
+    }
+    ssd1306->clip_x0 = 0;
+    ssd1306->clip_y0 = 0;
+    ssd1306->clip_x1 = ssd1306->width;
+    ssd1306->clip_y1 = ssd1306->height;
 }
 
-static bool ssd1306_send_command_value(ssd1306_t* ssd1306, uint8_t command, uint8_t value) {
-    return i2c_write_exact(i2c_write_timeout_us(ssd1306->i2c_inst, ssd1306->i2c_address, (uint8_t[]){SSD1306_SEND_COMMAND, command, value}, 3, false, SSD1306_I2C_TIMEOUT_US), 3);
+/**
+ * Check whether the framebuffer has changes not yet sent by ssd1306_show()
+*/
+bool ssd1306_is_dirty(const ssd1306_t* ssd1306) {
+    if (!ssd1306_is_ready(ssd1306)) {
+        return false;
+    }
+    const uint8_t pages = ssd1306_get_panel_height(ssd1306) / SSD1306_BITS_PER_COLUMN;
+    for (uint8_t page = 0; page < pages; page++) {
+        if (ssd1306->dirty_end[page] != 0) {
+            return true;
+        }
+    }
+    return false;
 }
 
 static bool ssd1306_send_command_2_values(ssd1306_t* ssd1306, uint8_t command, uint8_t value1, uint8_t value2) {
-    return i2c_write_exact(i2c_write_timeout_us(ssd1306->i2c_inst, ssd1306->i2c_address, (uint8_t[]){SSD1306_SEND_COMMAND, command, value1, value2}, 4, false, SSD1306_I2C_TIMEOUT_US), 4);
+    return ssd1306_i2c_write(ssd1306, (uint8_t[]){SSD1306_SEND_COMMAND, command, value1, value2}, 4);
+}
+
+/**
+ * Send a command transfer right away, bypassing the command queue. commands[0] is SSD1306_SEND_COMMAND.
+*/
+bool _ssd1306_send_commands(ssd1306_t* ssd1306, const uint8_t* commands, size_t len) {
+    return ssd1306 != NULL && ssd1306_i2c_write(ssd1306, commands, len);
+}
+
+static void ssd1306_persist_settings(ssd1306_t* ssd1306);
+
+// Phases of a flush in which queued commands are sent.
+#define SSD1306_QUEUE_BEFORE_FRAME 0x01
+#define SSD1306_QUEUE_AFTER_FRAME 0x02
+
+/**
+ * Commands of one group overwrite each other in the queue, only the last one matters.
+*/
+static uint8_t ssd1306_get_command_group(uint8_t command) {
+    if ((command & ~SSD1306_DISPLAY_START_LINE_MAX) == SSD1306_DISPLAY_START_LINE_COMMAND) {
+        return SSD1306_DISPLAY_START_LINE_COMMAND;
+    }
+    switch (command) {
+        case SSD1306_DISPLAY_INVERSE_COMMAND:
+            return SSD1306_DISPLAY_NORMAL_COMMAND;
+        case SSD1306_DISPLAY_ON_COMMAND:
+            return SSD1306_DISPLAY_OFF_COMMAND;
+        case SSD1306_SEGMENT_RE_MAP_INVERSE_COMMAND:
+            return SSD1306_SEGMENT_RE_MAP_NORMAL_COMMAND;
+        case SSD1306_COM_OUTPUT_SCAN_DIRECTION_REMAPPED_COMMAND:
+            return SSD1306_COM_OUTPUT_SCAN_DIRECTION_NORMAL_COMMAND;
+        default:
+            return command;
+    }
+}
+
+/**
+ * Display ON waits for the frame data, so the panel lights up with the new frame
+ * instead of stale RAM. So does the start line: rows scrolled into view are rewritten in
+ * RAM first, e.g. the row a console recycles. Everything else must take effect before the frame.
+*/
+static uint8_t ssd1306_get_command_phase(uint8_t command) {
+    if (command == SSD1306_DISPLAY_ON_COMMAND || ssd1306_get_command_group(command) == SSD1306_DISPLAY_START_LINE_COMMAND) {
+        return SSD1306_QUEUE_AFTER_FRAME;
+    }
+    return SSD1306_QUEUE_BEFORE_FRAME;
+}
+
+static bool ssd1306_has_addressing_modes(const ssd1306_controller_t* controller) {
+    return controller->addressing_modes != SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_PAGE);
+}
+
+/**
+ * Flush used by ssd1306_show(). A streaming display holds a single page, so it always flushes page by page.
+*/
+static ssd1306_flush_strategy_t ssd1306_get_flush_strategy(const ssd1306_t* ssd1306) {
+    return ssd1306->display_list != NULL ? SSD1306_FLUSH_PAGES : ssd1306->controller->flush;
+}
+
+/**
+ * Send queued commands of the given phases (and optionally the addressing mode of the
+ * flush used by ssd1306_show()) as one command transfer, then drop them from the queue.
+*/
+static bool ssd1306_send_queued_commands(ssd1306_t* ssd1306, uint8_t phases, bool with_addressing_mode) {
+    uint8_t commands[1 + (SSD1306_COMMAND_QUEUE_CAPACITY * 2) + 2];
+    uint8_t i = 0;
+    commands[i++] = SSD1306_SEND_COMMAND;
+
+    for (uint8_t q = 0; q < ssd1306->command_queue_len; q++) {
+        const ssd1306_queued_command_t* queued = &ssd1306->command_queue[q];
+        if ((ssd1306_get_command_phase(queued->command) & phases) == 0) {
+            continue;
+        }
+        commands[i++] = queued->command;
+        if (queued->has_value) {
+            commands[i++] = queued->value;
+        }
+    }
+
+    const bool has_settings = (i > 1);
+    if (with_addressing_mode && ssd1306_has_addressing_modes(ssd1306->controller)) {
+        commands[i++] = SSD1306_MEMORY_ADDRESSING_MODE_COMMAND;
+        commands[i++] = (ssd1306_get_flush_strategy(ssd1306) == SSD1306_FLUSH_WINDOW) ? SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL : SSD1306_MEMORY_ADDRESSING_MODE_PAGE;
+    }
+
+    if (i == 1) {
+        return true;
+    }
+    if (!ssd1306_i2c_write(ssd1306, commands, i)) {
+        return false;
+    }
+    if (has_settings) {
+        ssd1306_persist_settings(ssd1306);
+    }
+
+    uint8_t kept = 0;
+    for (uint8_t q = 0; q < ssd1306->command_queue_len; q++) {
+        if ((ssd1306_get_command_phase(ssd1306->command_queue[q].command) & phases) == 0) {
+            ssd1306->command_queue[kept++] = ssd1306->command_queue[q];
+        }
+    }
+    ssd1306->command_queue_len = kept;
+    return true;
+}
+
+/**
+ * Send all queued commands now, in one transfer
+*/
+bool ssd1306_flush_commands(ssd1306_t* ssd1306) {
+    if (ssd1306 == NULL) {
+        return false;
+    }
+    return ssd1306_send_queued_commands(ssd1306, SSD1306_QUEUE_BEFORE_FRAME | SSD1306_QUEUE_AFTER_FRAME, false);
+}
+
+/**
+ * Add a command to the queue, replacing a queued command of the same group.
+ * It is sent with the next flush, whatever the batching setting.
+*/
+static bool ssd1306_enqueue_command(ssd1306_t* ssd1306, uint8_t command, uint8_t value, bool has_value) {
+    if (ssd1306 == NULL) {
+        return false;
+    }
+
+    const ssd1306_queued_command_t queued = {
+        .command = command,
+        .value = value,
+        .has_value = has_value
+    };
+    const uint8_t group = ssd1306_get_command_group(command);
+    bool is_queued = false;
+    for (uint8_t q = 0; q < ssd1306->command_queue_len; q++) {
+        if (ssd1306_get_command_group(ssd1306->command_queue[q].command) == group) {
+            ssd1306->command_queue[q] = queued;
+            is_queued = true;
+            break;
+        }
+    }
+
+    if (!is_queued) {
+        if (ssd1306->command_queue_len == SSD1306_COMMAND_QUEUE_CAPACITY && !ssd1306_flush_commands(ssd1306)) {
+            return false;
+        }
+        ssd1306->command_queue[ssd1306->command_queue_len++] = queued;
+    }
+    return true;
+}
+
+/**
+ * Add a command to the queue. Without batching the queue is sent immediately.
+*/
+static bool ssd1306_queue_command(ssd1306_t* ssd1306, uint8_t command, uint8_t value, bool has_value) {
+    if (!ssd1306_enqueue_command(ssd1306, command, value, has_value)) {
+        return false;
+    }
+    return ssd1306->command_batching ? true : ssd1306_flush_commands(ssd1306);
+}
+
+/**
+ * Queue setter commands until the next ssd1306_show() instead of sending each one at once
+ * @param ssd1306
+ * @param enabled (default = false)
+*/
+void ssd1306_set_command_batching(ssd1306_t* ssd1306, bool enabled) {
+    if (ssd1306 == NULL) {
+        return;
+    }
+    ssd1306->command_batching = enabled;
 }
 
 /**
@@ -47,7 +545,10 @@ static bool ssd1306_send_command_2_values(ssd1306_t* ssd1306, uint8_t command, u
  * @param contrast (1-255) 0x7F = 127 (RESET)
 */
 bool ssd1306_set_contrast(ssd1306_t* ssd1306, uint8_t contrast) {
-    return ssd1306_send_command_value(ssd1306, SSD1306_CONTRAST_COMMAND, contrast);
+    if (ssd1306 != NULL) {
+        ssd1306->config.contrast = contrast;
+    }
+    return ssd1306_queue_command(ssd1306, SSD1306_CONTRAST_COMMAND, contrast, true);
 }
 
 /**
@@ -56,21 +557,85 @@ bool ssd1306_set_contrast(ssd1306_t* ssd1306, uint8_t contrast) {
  * @param enabled (RESET = false)
 */
 bool ssd1306_set_inverse(ssd1306_t* ssd1306, bool enabled) {
-    return ssd1306_send_command(ssd1306, enabled ? SSD1306_DISPLAY_INVERSE_COMMAND : SSD1306_DISPLAY_NORMAL_COMMAND);
+    if (ssd1306 != NULL) {
+        ssd1306->config.inverse = enabled;
+    }
+    return ssd1306_queue_command(ssd1306, enabled ? SSD1306_DISPLAY_INVERSE_COMMAND : SSD1306_DISPLAY_NORMAL_COMMAND, 0, false);
+}
+
+/**
+ * Set Display Start Line. The panel shows the RAM from this row on, wrapping around after row 63,
+ * so the picture scrolls vertically without sending it again.
+ * @param line (0-63) 0 (RESET)
+*/
+bool ssd1306_set_start_line(ssd1306_t* ssd1306, uint8_t line) {
+    if (line > SSD1306_DISPLAY_START_LINE_MAX) {
+        return false;
+    }
+    if (ssd1306 != NULL) {
+        ssd1306->config.start_line = line;
+    }
+    return ssd1306_queue_command(ssd1306, SSD1306_DISPLAY_START_LINE_COMMAND | line, 0, false);
+}
+
+/**
+ * Set the start line with the next flush, after its frame data, even without batching.
+ * For scrolling that rewrites the rows it brings into view.
+*/
+bool _ssd1306_set_start_line_after_frame(ssd1306_t* ssd1306, uint8_t line) {
+    if (ssd1306 == NULL || line > SSD1306_DISPLAY_START_LINE_MAX) {
+        return false;
+    }
+    ssd1306->config.start_line = line;
+    return ssd1306_enqueue_command(ssd1306, SSD1306_DISPLAY_START_LINE_COMMAND | line, 0, false);
+}
+
+/**
+ * Set Fade Out and Blinking. The controller changes the brightness by itself, without frame data
+ * or further commands: fade out dims the panel step by step and stays dark, blinking fades out
+ * and back in over and over. SSD1306_FADE_OUT_BLINKING_DISABLE restores the contrast at once.
+ * @param mode (RESET = SSD1306_FADE_OUT_BLINKING_DISABLE)
+ * @param interval (0-15) Each brightness step lasts 8 * (interval + 1) frames
+ * @return false if the controller has no fade (SSD1306_CONTROLLER_FADE_ZOOM)
+*/
+bool ssd1306_set_fade_out_blinking(ssd1306_t* ssd1306, ssd1306_fade_out_blinking_mode_t mode, uint8_t interval) {
+    if (ssd1306 == NULL || (ssd1306->controller->features & SSD1306_CONTROLLER_FADE_ZOOM) == 0 ||
+        interval > SSD1306_FADE_OUT_BLINKING_TIME_INTERVAL_MAX ||
+        (mode != SSD1306_FADE_OUT_BLINKING_DISABLE && mode != SSD1306_FADE_OUT_MODE && mode != SSD1306_BLINKING_MODE)) {
+        return false;
+    }
+    ssd1306->config.fade_out_blinking_mode = mode;
+    ssd1306->config.fade_out_time_interval = interval;
+    return ssd1306_queue_command(ssd1306, SSD1306_FADE_OUT_BLINKING_COMMAND, mode | interval, true);
+}
+
+/**
+ * Set Zoom In. Every row of the upper half of the panel is shown twice, filling the panel.
+ * @param enabled (RESET = false)
+ * @return false if the controller has no zoom (SSD1306_CONTROLLER_FADE_ZOOM) or the panel is
+ * 32 rows high: zoom needs the alternative COM pin configuration of the taller panels
+*/
+bool ssd1306_set_zoom(ssd1306_t* ssd1306, bool enabled) {
+    if (ssd1306 == NULL || (ssd1306->controller->features & SSD1306_CONTROLLER_FADE_ZOOM) == 0 ||
+        (enabled && ssd1306_get_panel_height(ssd1306) <= 32)) {
+        return false;
+    }
+    ssd1306->config.zoom = enabled;
+    return ssd1306_queue_command(ssd1306, SSD1306_ZOOM_IN_COMMAND, enabled ? SSD1306_ZOOM_IN_ENABLE : SSD1306_ZOOM_IN_DISABLE, true);
 }
 
 /**
  * Display ON
 */
 bool ssd1306_display_on(ssd1306_t* ssd1306) {
-    return ssd1306_send_command(ssd1306, SSD1306_DISPLAY_ON_COMMAND);
+    return ssd1306_queue_command(ssd1306, SSD1306_DISPLAY_ON_COMMAND, 0, false);
 }
 
 /**
  * Display OFF (sleep mode) (RESET)
 */
 bool ssd1306_display_off(ssd1306_t* ssd1306) {
-    return ssd1306_send_command(ssd1306, SSD1306_DISPLAY_OFF_COMMAND);
+    return ssd1306_queue_command(ssd1306, SSD1306_DISPLAY_OFF_COMMAND, 0, false);
 }
 
 /**
@@ -102,8 +667,8 @@ static bool ssd1306_set_area(ssd1306_t* ssd1306, uint8_t start_page, uint8_t end
         return false;
     }
 
-    const uint8_t max_page = (ssd1306->height / SSD1306_BITS_PER_COLUMN) - 1;
-    const uint8_t max_column = ssd1306->width - 1;
+    const uint8_t max_page = (ssd1306_get_panel_height(ssd1306) / SSD1306_BITS_PER_COLUMN) - 1;
+    const uint8_t max_column = ssd1306_get_panel_width(ssd1306) - 1;
 
     if (max_page > SSD1306_PAGE_END_ADDRESS || max_column > SSD1306_COLUMN_END_ADDRESS) {
         return false;
@@ -131,6 +696,8 @@ bool ssd1306_clear_display(ssd1306_t* ssd1306) {
         return false;
     }
     memset(ssd1306->buffer + 1, 0, ssd1306->buffer_size - 1);
+    ssd1306->display_list_size = 0;
+    ssd1306_mark_all_dirty(ssd1306);
     return true;
 }
 
@@ -148,6 +715,7 @@ ssd1306_config_t ssd1306_get_default_config() {
     settings.memory_addressing_mode = SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL;
 
     // 4. Hardware Configuration Command
+    settings.start_line = SSD1306_DISPLAY_START_LINE_MIN;
     settings.segment_re_map_inverse = true;
     settings.mux_ratio = SSD1306_MUX_RATIO_MAX;
     settings.com_output_scan_direction_remapped = true;
@@ -172,18 +740,138 @@ ssd1306_config_t ssd1306_get_default_config() {
     return settings;
 }
 
-ssd1306_t ssd1306_create(i2c_inst_t* i2c_inst, uint8_t i2c_address, ssd1306_display_size_t display_size) {
-    ssd1306_t ssd1306 = {
-        .i2c_inst = i2c_inst,
-        .i2c_address = i2c_address,
-        .width = 0,
-        .height = 0,
-        .font = NULL,
-        .buffer_size = 0,
-        .buffer = NULL
-    };
+static const uint8_t ssd1306_sh1106_init_commands[] = { SH1106_DC_DC_CONTROL_COMMAND, SH1106_DC_DC_ON };
+static const uint8_t ssd1306_ssd1309_init_commands[] = { SSD1309_COMMAND_LOCK_COMMAND, SSD1309_COMMAND_UNLOCK };
+
+const ssd1306_controller_t ssd1306_controller_ssd1306 = {
+    .name = "SSD1306",
+    .init_commands = NULL,
+    .init_commands_len = 0,
+    .ram_width = 128,
+    .column_offset = 0,
+    .addressing_modes = SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL) |
+                        SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_VERTICAL) |
+                        SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_PAGE),
+    .features = SSD1306_CONTROLLER_CHARGE_PUMP | SSD1306_CONTROLLER_FADE_ZOOM | SSD1306_CONTROLLER_CONTENT_SCROLL,
+    .flush = SSD1306_FLUSH_WINDOW
+};
 
-    switch (display_size) {
+// 132-column RAM with the 128-column panel centered on it, page addressing only, built-in DC-DC instead of a charge pump
+const ssd1306_controller_t ssd1306_controller_sh1106 = {
+    .name = "SH1106",
+    .init_commands = ssd1306_sh1106_init_commands,
+    .init_commands_len = sizeof(ssd1306_sh1106_init_commands),
+    .ram_width = 132,
+    .column_offset = 2,
+    .addressing_modes = SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_PAGE),
+    .features = 0,
+    .flush = SSD1306_FLUSH_PAGES
+};
+
+// Same addressing as SSD1306; external VCC and no fade or zoom. The command lock is cleared in case it was set.
+const ssd1306_controller_t ssd1306_controller_ssd1309 = {
+    .name = "SSD1309",
+    .init_commands = ssd1306_ssd1309_init_commands,
+    .init_commands_len = sizeof(ssd1306_ssd1309_init_commands),
+    .ram_width = 128,
+    .column_offset = 0,
+    .addressing_modes = SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL) |
+                        SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_VERTICAL) |
+                        SSD1306_ADDRESSING_MODE_BIT(SSD1306_MEMORY_ADDRESSING_MODE_PAGE),
+    .features = SSD1306_CONTROLLER_CONTENT_SCROLL,
+    .flush = SSD1306_FLUSH_WINDOW
+};
+
+/**
+ * Select the controller of the module, before ssd1306_init()
+ * @param ssd1306
+ * @param controller ssd1306_controller_ssd1306 (default), ssd1306_controller_sh1106, ssd1306_controller_ssd1309 or a custom descriptor
+ * @return false if the panel does not fit the controller RAM or its flush needs an addressing mode it lacks
+*/
+bool ssd1306_set_controller(ssd1306_t* ssd1306, const ssd1306_controller_t* controller) {
+    if (ssd1306 == NULL || controller == NULL || controller->init_commands_len > SSD1306_CONTROLLER_INIT_COMMANDS_MAX ||
+        (uint16_t)ssd1306_get_panel_width(ssd1306) + controller->column_offset > controller->ram_width) {
+        return false;
+    }
+    const ssd1306_memory_addressing_mode_t flush_mode = (controller->flush == SSD1306_FLUSH_WINDOW) ? SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL : SSD1306_MEMORY_ADDRESSING_MODE_PAGE;
+    if ((controller->addressing_modes & SSD1306_ADDRESSING_MODE_BIT(flush_mode)) == 0) {
+        return false;
+    }
+    ssd1306->controller = controller;
+    return true;
+}
+
+/**
+ * Scan directions that show the framebuffer at a rotation. 180 degrees flips both of them.
+ * 90 and 270 degrees flip one: ssd1306_show() sends the framebuffer transposed, which is a
+ * rotation mirrored across the panel.
+*/
+static uint8_t ssd1306_get_segment_re_map_command(ssd1306_rotation_t rotation, const ssd1306_config_t* config) {
+    const bool is_flipped = (rotation == SSD1306_ROTATION_90 || rotation == SSD1306_ROTATION_180);
+    return (config->segment_re_map_inverse != is_flipped) ? SSD1306_SEGMENT_RE_MAP_INVERSE_COMMAND : SSD1306_SEGMENT_RE_MAP_NORMAL_COMMAND;
+}
+
+static uint8_t ssd1306_get_com_scan_command(ssd1306_rotation_t rotation, const ssd1306_config_t* config) {
+    const bool is_flipped = (rotation == SSD1306_ROTATION_180 || rotation == SSD1306_ROTATION_270);
+    return (config->com_output_scan_direction_remapped != is_flipped) ? SSD1306_COM_OUTPUT_SCAN_DIRECTION_REMAPPED_COMMAND : SSD1306_COM_OUTPUT_SCAN_DIRECTION_NORMAL_COMMAND;
+}
+
+/**
+ * Rotate the picture on the panel, before or after ssd1306_init().
+ * 180 degrees only flips the scan directions of the controller, so drawing and flushing cost the same.
+ * 90 and 270 degrees swap ssd1306->width and ssd1306->height. Drawing works on the portrait framebuffer
+ * as usual, and ssd1306_show() transposes the changed 8x8 blocks into panel layout while sending them.
+ * Switching between landscape and portrait clears the framebuffer and resets the clip.
+ * The next ssd1306_show() sends the whole frame.
+ * @param ssd1306
+ * @param rotation (default = SSD1306_ROTATION_0)
+ * @return false for an invalid rotation, 90 or 270 degrees in page-streaming mode, or if the new scan directions were not sent
+*/
+bool ssd1306_set_rotation(ssd1306_t* ssd1306, ssd1306_rotation_t rotation) {
+    if (!ssd1306_is_ready(ssd1306) || rotation > SSD1306_ROTATION_270) {
+        return false;
+    }
+    const bool is_portrait = ssd1306_is_rotation_portrait(rotation);
+    // A streaming display rasterizes one panel page at a time, which is not a framebuffer page in portrait.
+    if (is_portrait && ssd1306->display_list != NULL) {
+        return false;
+    }
+
+    if (is_portrait != ssd1306_is_portrait(ssd1306)) {
+        const uint8_t width = ssd1306->width;
+        ssd1306->width = ssd1306->height;
+        ssd1306->height = width;
+        memset(ssd1306->buffer + 1, 0, ssd1306->buffer_size - 1);
+        ssd1306->display_list_size = 0;
+        ssd1306_reset_clip(ssd1306);
+    }
+    ssd1306->rotation = rotation;
+    // The segment re-map only applies to data written after it, so the RAM is written again.
+    ssd1306_mark_all_dirty(ssd1306);
+
+    if (!ssd1306->is_configured) {
+        return true; // Applied by ssd1306_init()
+    }
+    const bool is_ok = ssd1306_queue_command(ssd1306, ssd1306_get_segment_re_map_command(rotation, &ssd1306->config), 0, false);
+    return ssd1306_queue_command(ssd1306, ssd1306_get_com_scan_command(rotation, &ssd1306->config), 0, false) && is_ok;
+}
+
+static ssd1306_t ssd1306_create_unallocated(i2c_inst_t* i2c_inst, uint8_t i2c_address, ssd1306_display_size_t display_size) {
+    ssd1306_t ssd1306 = {
+        .i2c_inst = i2c_inst,
+        .i2c_address = i2c_address,
+        .controller = &ssd1306_controller_ssd1306,
+        .width = 0,
+        .height = 0,
+        .rotation = SSD1306_ROTATION_0,
+        .font = NULL,
+        .text_scale = 1,
+        .text_bold = false,
+        .buffer_size = 0,
+        .buffer = NULL
+    };
+
+    switch (display_size) {
         case SSD1306_DISPLAY_SIZE_128x64:
             ssd1306.width = 128;
             ssd1306.height = 64;
@@ -195,320 +883,2001 @@ ssd1306_t ssd1306_create(i2c_inst_t* i2c_inst, uint8_t i2c_address, ssd1306_disp
         default:
             return ssd1306;
     }
+    ssd1306.clip_x1 = ssd1306.width;
+    ssd1306.clip_y1 = ssd1306.height;
+    return ssd1306;
+}
 
-    const uint16_t display_bytes = ssd1306_get_display_bytes(&ssd1306);
+static void ssd1306_allocate_buffer(ssd1306_t* ssd1306, uint16_t display_bytes) {
     // +1 for the leading I2C control byte (SSD1306_SEND_DATA) before framebuffer bytes.
-    ssd1306.buffer_size = display_bytes + 1;
-    ssd1306.buffer = (uint8_t*)malloc(ssd1306.buffer_size);
-    if (ssd1306.buffer == NULL) {
-        ssd1306.buffer_size = 0;
-        return ssd1306;
+    ssd1306->buffer_size = display_bytes + 1;
+    ssd1306->buffer = (uint8_t*)malloc(ssd1306->buffer_size);
+    if (ssd1306->buffer == NULL) {
+        ssd1306->buffer_size = 0;
+        return;
     }
 
-    ssd1306.buffer[0] = SSD1306_SEND_DATA;
-    memset(ssd1306.buffer + 1, 0, display_bytes);
+    ssd1306->buffer[0] = SSD1306_SEND_DATA;
+    memset(ssd1306->buffer + 1, 0, display_bytes);
+}
 
+ssd1306_t ssd1306_create(i2c_inst_t* i2c_inst, uint8_t i2c_address, ssd1306_display_size_t display_size) {
+    ssd1306_t ssd1306 = ssd1306_create_unallocated(i2c_inst, i2c_address, display_size);
+    if (ssd1306_has_valid_geometry(&ssd1306)) {
+        ssd1306_allocate_buffer(&ssd1306, ssd1306_get_display_bytes(&ssd1306));
+    }
     return ssd1306;
 };
 
-bool ssd1306_init(ssd1306_t* ssd1306, const ssd1306_config_t* config) {
-    if (config == NULL || !ssd1306_is_ready(ssd1306)) {
-        return false;
+/**
+ * Create an ssd1306 instance without a framebuffer. Draw calls are recorded into a display list
+ * and ssd1306_show() rasterizes the list one page at a time into a single page buffer,
+ * sending each page right away.
+ * @param display_list_capacity Bytes for recorded draw calls: a bitmap takes one record,
+ *        text takes one record plus its length (see ssd1306_display_list_entry_t)
+*/
+ssd1306_t ssd1306_create_streaming(i2c_inst_t* i2c_inst, uint8_t i2c_address, ssd1306_display_size_t display_size, uint16_t display_list_capacity) {
+    ssd1306_t ssd1306 = ssd1306_create_unallocated(i2c_inst, i2c_address, display_size);
+    if (!ssd1306_has_valid_geometry(&ssd1306) || display_list_capacity < sizeof(ssd1306_display_list_entry_t)) {
+        return ssd1306;
     }
 
-    ssd1306->buffer[0] = SSD1306_SEND_DATA;
-    memset(ssd1306->buffer + 1, 0, ssd1306->buffer_size - 1);
+    ssd1306.display_list = (uint8_t*)malloc(display_list_capacity);
+    if (ssd1306.display_list == NULL) {
+        return ssd1306;
+    }
+    ssd1306.display_list_capacity = display_list_capacity;
 
-    uint8_t commands[SSD1306_INIT_COMMANDS_CAPACITY];
-    uint8_t i = 0;
-    commands[i++] = SSD1306_SEND_COMMAND;
+    ssd1306_allocate_buffer(&ssd1306, ssd1306.width);
+    if (ssd1306.buffer == NULL) {
+        free(ssd1306.display_list);
+        ssd1306.display_list = NULL;
+        ssd1306.display_list_capacity = 0;
+    }
+    return ssd1306;
+}
 
-    // Ensure deterministic init even without a dedicated RESET pin.
-    commands[i++] = SSD1306_DISPLAY_OFF_COMMAND;
+static ssd1306_queued_command_t ssd1306_setting(uint8_t command) {
+    return (ssd1306_queued_command_t){ .command = command, .value = 0, .has_value = false };
+}
+
+static ssd1306_queued_command_t ssd1306_setting_value(uint8_t command, uint8_t value) {
+    return (ssd1306_queued_command_t){ .command = command, .value = value, .has_value = true };
+}
+
+/**
+ * Translate config into the controller settings sent between display OFF and display ON.
+ * The order and number of settings is fixed, so two lists can be compared entry by entry.
+ * @return number of settings, 0 if config is invalid
+*/
+static uint8_t ssd1306_build_init_settings(const ssd1306_t* ssd1306, const ssd1306_config_t* config, ssd1306_queued_command_t* settings) {
+    const ssd1306_controller_t* controller = ssd1306->controller;
+    uint8_t i = 0;
 
     // Match controller scan geometry to the selected panel size.
-    const uint8_t geometry_mux_ratio = ssd1306->height - 1;
-    const bool geometry_com_alt_pin_config = (ssd1306->height > 32);
+    const uint8_t panel_height = ssd1306_get_panel_height(ssd1306);
+    const uint8_t geometry_mux_ratio = panel_height - 1;
+    const bool geometry_com_alt_pin_config = (panel_height > 32);
 
-    commands[i++] = config->com_output_scan_direction_remapped ? SSD1306_COM_OUTPUT_SCAN_DIRECTION_REMAPPED_COMMAND : SSD1306_COM_OUTPUT_SCAN_DIRECTION_NORMAL_COMMAND;
+    settings[i++] = ssd1306_setting(ssd1306_get_com_scan_command(ssd1306->rotation, config));
 
-    if (geometry_mux_ratio < SSD1306_MUX_RATIO_MIN || geometry_mux_ratio > SSD1306_MUX_RATIO_MAX) return false;
-    commands[i++] = SSD1306_MUX_RATIO_COMMAND;
-    commands[i++] = geometry_mux_ratio;
+    if (geometry_mux_ratio < SSD1306_MUX_RATIO_MIN || geometry_mux_ratio > SSD1306_MUX_RATIO_MAX) return 0;
+    settings[i++] = ssd1306_setting_value(SSD1306_MUX_RATIO_COMMAND, geometry_mux_ratio);
 
     if (config->divide_ratio < SSD1306_DISPLAY_CLOCK_DIVIDE_RATIO_MIN ||
         config->divide_ratio > SSD1306_DISPLAY_CLOCK_DIVIDE_RATIO_MAX ||
         config->oscillator_frequency < SSD1306_DISPLAY_CLOCK_OSCILLATOR_FREQUENCY_MIN ||
         config->oscillator_frequency > SSD1306_DISPLAY_CLOCK_OSCILLATOR_FREQUENCY_MAX) {
-        return false;
+        return 0;
     }
-    commands[i++] = SSD1306_DISPLAY_CLOCK_DIVIDE_COMMAND;
-    commands[i++] = (config->divide_ratio) | (config->oscillator_frequency << 4);
-    
-    commands[i++] = config->inverse ? SSD1306_DISPLAY_INVERSE_COMMAND : SSD1306_DISPLAY_NORMAL_COMMAND;
-    commands[i++] = SSD1306_ENTIRE_DISPLAY_ON_COMMAND; // A4: disable "entire display ON" override and render RAM again (opposite of A5)
-    commands[i++] = SSD1306_DISPLAY_START_LINE_COMMAND; // Start line = 0
-    
-    commands[i++] = SSD1306_CONTRAST_COMMAND;
-    commands[i++] = config->contrast;
+    settings[i++] = ssd1306_setting_value(SSD1306_DISPLAY_CLOCK_DIVIDE_COMMAND, (config->divide_ratio) | (config->oscillator_frequency << 4));
+
+    settings[i++] = ssd1306_setting(config->inverse ? SSD1306_DISPLAY_INVERSE_COMMAND : SSD1306_DISPLAY_NORMAL_COMMAND);
+    settings[i++] = ssd1306_setting(SSD1306_ENTIRE_DISPLAY_ON_COMMAND); // A4: disable "entire display ON" override and render RAM again (opposite of A5)
+    if (config->start_line > SSD1306_DISPLAY_START_LINE_MAX) return 0;
+    settings[i++] = ssd1306_setting(SSD1306_DISPLAY_START_LINE_COMMAND | config->start_line);
+
+    settings[i++] = ssd1306_setting_value(SSD1306_CONTRAST_COMMAND, config->contrast);
 
     if (config->fade_out_time_interval < SSD1306_FADE_OUT_BLINKING_TIME_INTERVAL_MIN ||
         config->fade_out_time_interval > SSD1306_FADE_OUT_BLINKING_TIME_INTERVAL_MAX) {
-        return false;
+        return 0;
+    }
+    if (controller->features & SSD1306_CONTROLLER_FADE_ZOOM) {
+        settings[i++] = ssd1306_setting_value(SSD1306_FADE_OUT_BLINKING_COMMAND, config->fade_out_blinking_mode | config->fade_out_time_interval);
+        settings[i++] = ssd1306_setting_value(SSD1306_ZOOM_IN_COMMAND, config->zoom ? SSD1306_ZOOM_IN_ENABLE : SSD1306_ZOOM_IN_DISABLE);
+    }
+
+    settings[i++] = ssd1306_setting_value(SSD1306_DISPLAY_OFFSET_COMMAND, SSD1306_DISPLAY_OFFSET_MIN);
+
+    if (ssd1306_has_addressing_modes(controller)) {
+        if ((controller->addressing_modes & SSD1306_ADDRESSING_MODE_BIT(config->memory_addressing_mode)) == 0) {
+            return 0;
+        }
+        settings[i++] = ssd1306_setting_value(SSD1306_MEMORY_ADDRESSING_MODE_COMMAND, config->memory_addressing_mode);
     }
-    commands[i++] = SSD1306_FADE_OUT_BLINKING_COMMAND;
-    commands[i++] = config->fade_out_blinking_mode | config->fade_out_time_interval;
-    
-    commands[i++] = SSD1306_ZOOM_IN_COMMAND;
-    commands[i++] = config->zoom ? SSD1306_ZOOM_IN_ENABLE : SSD1306_ZOOM_IN_DISABLE;
-    
-    commands[i++] = SSD1306_DISPLAY_OFFSET_COMMAND;
-    commands[i++] = SSD1306_DISPLAY_OFFSET_MIN;
-    
-    commands[i++] = SSD1306_MEMORY_ADDRESSING_MODE_COMMAND;
-    commands[i++] = config->memory_addressing_mode;
-    
+
     if (config->pre_charge_period_phase_1 < SSD1306_PRE_CHARGE_PERIOD_PHASE_MIN ||
         config->pre_charge_period_phase_1 > SSD1306_PRE_CHARGE_PERIOD_PHASE_MAX ||
         config->pre_charge_period_phase_2 < SSD1306_PRE_CHARGE_PERIOD_PHASE_MIN ||
         config->pre_charge_period_phase_2 > SSD1306_PRE_CHARGE_PERIOD_PHASE_MAX) {
-        return false;
+        return 0;
     }
-    commands[i++] = SSD1306_PRE_CHARGE_PERIOD_COMMAND;
-    commands[i++] = (config->pre_charge_period_phase_1 << 4) | config->pre_charge_period_phase_2;
-    
-    commands[i++] = SSD1306_VCOMH_DESELECT_LEVEL_COMMAND;
-    commands[i++] = config->vcomh_deselect_level;
-    
+    settings[i++] = ssd1306_setting_value(SSD1306_PRE_CHARGE_PERIOD_COMMAND, (config->pre_charge_period_phase_1 << 4) | config->pre_charge_period_phase_2);
+
+    settings[i++] = ssd1306_setting_value(SSD1306_VCOMH_DESELECT_LEVEL_COMMAND, config->vcomh_deselect_level);
+
     const uint8_t com_pins_val1 = geometry_com_alt_pin_config ? SSD1306_COM_PINS_HARDWARE_CONFIG_ALTERNATIVE_COM_PIN : SSD1306_COM_PINS_HARDWARE_CONFIG_SEQUENTIAL_COM_PIN;
     const uint8_t com_pins_val2 = config->com_disable_left_right_remap ? SSD1306_COM_PINS_HARDWARE_CONFIG_DISABLE_REMAP : SSD1306_COM_PINS_HARDWARE_CONFIG_ENABLE_REMAP;
-    commands[i++] = SSD1306_COM_PINS_HARDWARE_CONFIG_COMMAND;
-    commands[i++] = com_pins_val1 | com_pins_val2;
-    
-    commands[i++] = config->segment_re_map_inverse ? SSD1306_SEGMENT_RE_MAP_INVERSE_COMMAND : SSD1306_SEGMENT_RE_MAP_NORMAL_COMMAND;
-    
-    commands[i++] = SSD1306_CHARGE_PUMP_COMMAND;
-    commands[i++] = config->charge_pump ? SSD1306_CHARGE_PUMP_ENABLE : SSD1306_CHARGE_PUMP_DISABLE;
-    
+    settings[i++] = ssd1306_setting_value(SSD1306_COM_PINS_HARDWARE_CONFIG_COMMAND, com_pins_val1 | com_pins_val2);
+
+    settings[i++] = ssd1306_setting(ssd1306_get_segment_re_map_command(ssd1306->rotation, config));
+
+    if (controller->features & SSD1306_CONTROLLER_CHARGE_PUMP) {
+        settings[i++] = ssd1306_setting_value(SSD1306_CHARGE_PUMP_COMMAND, config->charge_pump ? SSD1306_CHARGE_PUMP_ENABLE : SSD1306_CHARGE_PUMP_DISABLE);
+    }
+
+    return i;
+}
+
+static uint8_t ssd1306_append_settings(uint8_t* commands, uint8_t i, const ssd1306_queued_command_t* settings, uint8_t count) {
+    for (uint8_t s = 0; s < count; s++) {
+        commands[i++] = settings[s].command;
+        if (settings[s].has_value) {
+            commands[i++] = settings[s].value;
+        }
+    }
+    return i;
+}
+
+static bool ssd1306_send_init_sequence(ssd1306_t* ssd1306, const ssd1306_config_t* config) {
+    ssd1306_queued_command_t settings[SSD1306_INIT_SETTINGS_CAPACITY];
+    const uint8_t count = ssd1306_build_init_settings(ssd1306, config, settings);
+    if (count == 0) {
+        return false;
+    }
+
+    uint8_t commands[SSD1306_INIT_COMMANDS_CAPACITY];
+    uint8_t i = 0;
+    commands[i++] = SSD1306_SEND_COMMAND;
+
+    // Controller-specific commands come first, e.g. the SSD1309 command unlock must precede everything else.
+    const ssd1306_controller_t* controller = ssd1306->controller;
+    if (controller->init_commands_len > 0) {
+        memcpy(&commands[i], controller->init_commands, controller->init_commands_len);
+        i += controller->init_commands_len;
+    }
+
+    // Ensure deterministic init even without a dedicated RESET pin.
+    commands[i++] = SSD1306_DISPLAY_OFF_COMMAND;
+    i = ssd1306_append_settings(commands, i, settings, count);
     commands[i++] = SSD1306_DISPLAY_ON_COMMAND;
 
-    return i2c_write_exact(i2c_write_timeout_us(ssd1306->i2c_inst, ssd1306->i2c_address, commands, i, false, SSD1306_I2C_TIMEOUT_US), i);
+    if (!ssd1306_i2c_write(ssd1306, commands, i)) {
+        return false;
+    }
+    ssd1306->consecutive_naks = 0;
+    return true;
+}
+
+typedef struct {
+    uint8_t i2c_index;
+    uint8_t i2c_address;
+    uint8_t count;
+    ssd1306_queued_command_t settings[SSD1306_INIT_SETTINGS_CAPACITY];
+} ssd1306_persisted_settings_t;
+
+// Controller settings as last sent, kept across soft resets (not zeroed at boot).
+// A slot is valid only while its hash matches the watchdog scratch register, which a power-on reset clears.
+// Slots and scratch registers are only accessed with SSD1306_WARM_INIT_SPINLOCK held.
+static ssd1306_persisted_settings_t __uninitialized_ram(ssd1306_persisted_settings)[SSD1306_WARM_INIT_SLOTS];
+
+// FNV-1a. Never returns 0, the value of a cleared scratch register.
+static uint32_t ssd1306_hash_persisted_settings(const ssd1306_persisted_settings_t* record) {
+    uint32_t hash = 2166136261u;
+    const uint8_t header[] = { record->i2c_index, record->i2c_address, record->count };
+    for (uint8_t i = 0; i < sizeof(header); i++) {
+        hash = (hash ^ header[i]) * 16777619u;
+    }
+    const uint8_t count = record->count <= SSD1306_INIT_SETTINGS_CAPACITY ? record->count : SSD1306_INIT_SETTINGS_CAPACITY;
+    for (uint8_t i = 0; i < count; i++) {
+        hash = (hash ^ record->settings[i].command) * 16777619u;
+        hash = (hash ^ record->settings[i].value) * 16777619u;
+        hash = (hash ^ (record->settings[i].has_value ? 1u : 0u)) * 16777619u;
+    }
+    return hash | 1u;
+}
+
+static bool ssd1306_is_persisted_slot_valid(uint8_t slot) {
+    return watchdog_hw->scratch[SSD1306_WARM_INIT_SCRATCH + slot] == ssd1306_hash_persisted_settings(&ssd1306_persisted_settings[slot]);
+}
+
+/**
+ * Find the persisted settings of this display.
+ * @param for_write also return a free slot when there is no match; a slot valid for another display is never returned
+*/
+static ssd1306_persisted_settings_t* ssd1306_find_persisted_settings(const ssd1306_t* ssd1306, bool for_write, uint8_t* slot_out) {
+    const uint8_t i2c_index = (uint8_t)i2c_get_index(ssd1306->i2c_inst);
+    int16_t free_slot = -1;
+    for (uint8_t slot = 0; slot < SSD1306_WARM_INIT_SLOTS; slot++) {
+        const ssd1306_persisted_settings_t* record = &ssd1306_persisted_settings[slot];
+        if (!ssd1306_is_persisted_slot_valid(slot)) {
+            if (free_slot < 0) {
+                free_slot = slot;
+            }
+            continue;
+        }
+        if (record->i2c_index == i2c_index && record->i2c_address == ssd1306->i2c_address) {
+            *slot_out = slot;
+            return &ssd1306_persisted_settings[slot];
+        }
+    }
+    if (!for_write || free_slot < 0) {
+        return NULL;
+    }
+    *slot_out = (uint8_t)free_slot;
+    return &ssd1306_persisted_settings[*slot_out];
+}
+
+/**
+ * Remember the settings now active on the controller for ssd1306_init_warm() after a soft reset.
+ * Only displays initialized with ssd1306_init_warm() are persisted.
+*/
+static void ssd1306_persist_settings(ssd1306_t* ssd1306) {
+    if (!ssd1306->is_configured || !ssd1306->warm_start) {
+        return;
+    }
+    // Built and hashed outside the lock, which is held only to claim the slot and copy the record.
+    ssd1306_persisted_settings_t record = {};
+    record.i2c_index = (uint8_t)i2c_get_index(ssd1306->i2c_inst);
+    record.i2c_address = ssd1306->i2c_address;
+    record.count = ssd1306_build_init_settings(ssd1306, &ssd1306->config, record.settings);
+    const uint32_t hash = ssd1306_hash_persisted_settings(&record);
+
+    spin_lock_t* lock = spin_lock_instance(SSD1306_WARM_INIT_SPINLOCK);
+    const uint32_t irq_state = spin_lock_blocking(lock);
+    uint8_t slot;
+    ssd1306_persisted_settings_t* persisted = ssd1306_find_persisted_settings(ssd1306, true, &slot);
+    if (persisted != NULL) {
+        *persisted = record;
+        watchdog_hw->scratch[SSD1306_WARM_INIT_SCRATCH + slot] = hash;
+    }
+    spin_unlock(lock, irq_state);
+}
+
+/**
+ * Copy the persisted settings of this display
+ * @return false if there are none
+*/
+static bool ssd1306_load_persisted_settings(const ssd1306_t* ssd1306, ssd1306_persisted_settings_t* record) {
+    spin_lock_t* lock = spin_lock_instance(SSD1306_WARM_INIT_SPINLOCK);
+    const uint32_t irq_state = spin_lock_blocking(lock);
+    uint8_t slot;
+    const ssd1306_persisted_settings_t* persisted = ssd1306_find_persisted_settings(ssd1306, false, &slot);
+    if (persisted != NULL) {
+        *record = *persisted;
+    }
+    spin_unlock(lock, irq_state);
+    return persisted != NULL;
+}
+
+static bool ssd1306_read_status(ssd1306_t* ssd1306, uint8_t* status) {
+    return i2c_read_timeout_us(ssd1306->i2c_inst, ssd1306->i2c_address, status, 1, false, ssd1306_get_transfer_timeout_us(ssd1306, 1)) == 1;
 }
 
-static bool _ssd1306_draw_bitmap_internal(ssd1306_t* ssd1306, const uint8_t* bitmap, uint32_t offset, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y) {
-    if (!ssd1306_is_ready(ssd1306) || width == 0 || height == 0) {
+bool ssd1306_init(ssd1306_t* ssd1306, const ssd1306_config_t* config) {
+    if (config == NULL || !ssd1306_is_ready(ssd1306)) {
         return false;
     }
 
-    const uint8_t *bitmap_data = &bitmap[offset];
-    const uint16_t bitmap_bytes_per_row = (width + 7) / 8;
-    const uint16_t display_width = ssd1306->width;
-    const uint16_t display_height = ssd1306->height;
+    ssd1306->buffer[0] = SSD1306_SEND_DATA;
+    memset(ssd1306->buffer + 1, 0, ssd1306->buffer_size - 1);
+    ssd1306->display_list_size = 0;
+    // Controller RAM content is unknown after init, so the next flush must be complete.
+    ssd1306_mark_all_dirty(ssd1306);
+
+    if (!ssd1306_send_init_sequence(ssd1306, config)) {
+        return false;
+    }
+    ssd1306->config = *config;
+    ssd1306->is_configured = true;
+    ssd1306_persist_settings(ssd1306);
+    return true;
+}
+
+/**
+ * Initialize after an MCU soft reset (e.g. watchdog) without blanking the panel.
+ * If the controller answers, its display is on and settings persisted before the reset
+ * are valid, only settings that differ from config are sent: no display OFF/ON, no clear.
+ * Otherwise this is a regular ssd1306_init().
+ * From now on the settings of this display are persisted whenever they change.
+ * The framebuffer is marked dirty, so the first ssd1306_show() uploads one full frame.
+*/
+bool ssd1306_init_warm(ssd1306_t* ssd1306, const ssd1306_config_t* config) {
+    if (config == NULL || !ssd1306_is_ready(ssd1306)) {
+        return false;
+    }
+    ssd1306->warm_start = true;
+
+    ssd1306_queued_command_t settings[SSD1306_INIT_SETTINGS_CAPACITY];
+    const uint8_t count = ssd1306_build_init_settings(ssd1306, config, settings);
+    if (count == 0) {
+        return false;
+    }
+
+    ssd1306_persisted_settings_t persisted;
+    uint8_t status;
+    if (!ssd1306_load_persisted_settings(ssd1306, &persisted) || persisted.count != count || !ssd1306_read_status(ssd1306, &status) || (status & SSD1306_STATUS_DISPLAY_OFF) != 0) {
+        return ssd1306_init(ssd1306, config);
+    }
+
+    uint8_t commands[SSD1306_INIT_COMMANDS_CAPACITY];
+    uint8_t i = 0;
+    commands[i++] = SSD1306_SEND_COMMAND;
+    for (uint8_t s = 0; s < count; s++) {
+        const ssd1306_queued_command_t* current = &persisted.settings[s];
+        if (current->command != settings[s].command || current->value != settings[s].value || current->has_value != settings[s].has_value) {
+            i = ssd1306_append_settings(commands, i, &settings[s], 1);
+        }
+    }
+    if (i > 1 && !ssd1306_i2c_write(ssd1306, commands, i)) {
+        return ssd1306_init(ssd1306, config);
+    }
+
+    ssd1306->consecutive_naks = 0;
+    ssd1306->buffer[0] = SSD1306_SEND_DATA;
+    ssd1306_mark_all_dirty(ssd1306);
+    ssd1306->config = *config;
+    ssd1306->is_configured = true;
+    ssd1306_persist_settings(ssd1306);
+    return true;
+}
+
+/**
+ * A run of NAKs means the controller dropped off the bus, typically a brown-out reset.
+ * It stays true after the controller answers again, until it has been initialized.
+*/
+static bool ssd1306_is_nak_storm(const ssd1306_t* ssd1306) {
+    return ssd1306->is_configured && ssd1306->consecutive_naks >= SSD1306_NAK_STORM_THRESHOLD;
+}
+
+/**
+ * Send the init sequence again with the stored config, keep the framebuffer
+ * and schedule a full repaint, since controller RAM is lost.
+*/
+static bool ssd1306_recover_controller(ssd1306_t* ssd1306) {
+    if (!ssd1306_send_init_sequence(ssd1306, &ssd1306->config)) {
+        return false;
+    }
+#if SSD1306_ENABLE_STATS
+    ssd1306->stats.controller_reinits++;
+#endif
+    ssd1306_mark_all_dirty(ssd1306);
+    return true;
+}
+
+/**
+ * Read 8 source pixels starting at bit `shift` of byte `index`, without reading past the row.
+*/
+static inline uint8_t ssd1306_fetch_source_byte(const uint8_t* row, uint16_t index, uint8_t shift, uint16_t row_bytes) {
+    if (shift == 0) {
+        return row[index];
+    }
+    uint8_t value = (uint8_t)(row[index] >> shift);
+    if (index + 1 < row_bytes) {
+        value |= (uint8_t)(row[index + 1] << (8 - shift));
+    }
+    return value;
+}
+
+/**
+ * Blit a sub-rectangle of an LSB row-major 1bpp image into the framebuffer, clipped to the clip rectangle.
+ * @param data first byte of the image
+ * @param mask optional image of the same layout, 1 = draw the pixel, 0 = keep the framebuffer
+ * @param row_bytes bytes per image row
+ * @param src_x, src_y top-left of the sub-rectangle in the image
+ * @param start_x, start_y destination, may be negative
+*/
+bool _ssd1306_blit_rect(ssd1306_t* ssd1306, const uint8_t* data, const uint8_t* mask, uint16_t row_bytes, uint16_t src_x, uint16_t src_y, uint16_t width, uint16_t height, int16_t start_x, int16_t start_y) {
+    if (!ssd1306_is_ready(ssd1306) || data == NULL || width == 0 || height == 0) {
+        return false;
+    }
 
-    // Fast reject when bitmap starts fully outside visible area.
-    if (start_x >= display_width || start_y >= display_height) {
+    // Clip the destination rectangle once, so the hot loops below stay branch-light.
+    const int16_t x0 = start_x > ssd1306->clip_x0 ? start_x : ssd1306->clip_x0;
+    const int16_t y0 = start_y > ssd1306->clip_y0 ? start_y : ssd1306->clip_y0;
+    const int16_t x1 = (start_x + (int16_t)width) < ssd1306->clip_x1 ? (start_x + (int16_t)width) : ssd1306->clip_x1;
+    const int16_t y1 = (start_y + (int16_t)height) < ssd1306->clip_y1 ? (start_y + (int16_t)height) : ssd1306->clip_y1;
+    if (x0 >= x1 || y0 >= y1) {
         return true;
     }
 
-    // Clip the source rectangle once, so the hot loops below stay branch-light.
-    const bool clipped_x = ((uint16_t)start_x + width > display_width);
-    const bool clipped_y = ((uint16_t)start_y + height > display_height);
-    const uint16_t draw_width = clipped_x ? (display_width - start_x) : width;
-    const uint16_t draw_height = clipped_y ? (display_height - start_y) : height;
+    const uint16_t draw_width = (uint16_t)(x1 - x0);
+    const uint16_t draw_height = (uint16_t)(y1 - y0);
+    const uint16_t first_src_column = src_x + (uint16_t)(x0 - start_x);
+    const uint16_t first_src_row = src_y + (uint16_t)(y0 - start_y);
+    const uint16_t first_src_byte = first_src_column >> 3;
+    const uint8_t shift = (uint8_t)(first_src_column & 0x07);
+    const uint16_t src_row_bytes = row_bytes - first_src_byte;
+    const uint16_t display_width = ssd1306->width;
 
     // Split each source row into full 8-pixel chunks and optional tail bits.
     const uint16_t full_bytes = draw_width >> 3;
     const uint16_t tail_bits = draw_width & 0x07;
 
-    for (uint16_t y_in_bitmap = 0; y_in_bitmap < draw_height; y_in_bitmap++) {
-        const uint16_t visual_y = start_y + y_in_bitmap;
+    for (uint16_t row = 0; row < draw_height; row++) {
+        const uint16_t visual_y = (uint16_t)y0 + row;
         // SSD1306 framebuffer is page-based: one byte stores 8 vertical pixels in a column.
         const uint16_t page = visual_y >> 3;
-        const uint8_t buffer_bit = (uint8_t)(visual_y & 0x07);
-        const uint8_t bitmask = (uint8_t)(1u << buffer_bit);
+        const uint8_t bitmask = (uint8_t)(1u << (visual_y & 0x07));
         const uint8_t inv_bitmask = (uint8_t)~bitmask;
-        const uint16_t row_base = y_in_bitmap * bitmap_bytes_per_row;
-        const uint16_t buffer_row_base = (page * display_width) + start_x + 1; // +1 skips SSD1306_SEND_DATA control byte
+        const uint32_t src_row_base = (uint32_t)(first_src_row + row) * row_bytes + first_src_byte;
+        const uint8_t* src_row = &data[src_row_base];
+        const uint8_t* mask_row = (mask != NULL) ? &mask[src_row_base] : NULL;
+        uint8_t* dst = ssd1306->buffer + 1 + ((page - ssd1306->buffer_page) * display_width) + x0; // +1 skips SSD1306_SEND_DATA control byte
 
         // Fast path for complete bytes from source row.
         for (uint16_t src_byte_idx = 0; src_byte_idx < full_bytes; src_byte_idx++) {
-            const uint8_t src_byte = bitmap_data[row_base + src_byte_idx];
-            const uint16_t buffer_index = buffer_row_base + (src_byte_idx << 3);
-            ssd1306->buffer[buffer_index + 0] = (ssd1306->buffer[buffer_index + 0] & inv_bitmask) | ((src_byte & (1u << 0)) ? bitmask : 0u);
-            ssd1306->buffer[buffer_index + 1] = (ssd1306->buffer[buffer_index + 1] & inv_bitmask) | ((src_byte & (1u << 1)) ? bitmask : 0u);
-            ssd1306->buffer[buffer_index + 2] = (ssd1306->buffer[buffer_index + 2] & inv_bitmask) | ((src_byte & (1u << 2)) ? bitmask : 0u);
-            ssd1306->buffer[buffer_index + 3] = (ssd1306->buffer[buffer_index + 3] & inv_bitmask) | ((src_byte & (1u << 3)) ? bitmask : 0u);
-            ssd1306->buffer[buffer_index + 4] = (ssd1306->buffer[buffer_index + 4] & inv_bitmask) | ((src_byte & (1u << 4)) ? bitmask : 0u);
-            ssd1306->buffer[buffer_index + 5] = (ssd1306->buffer[buffer_index + 5] & inv_bitmask) | ((src_byte & (1u << 5)) ? bitmask : 0u);
-            ssd1306->buffer[buffer_index + 6] = (ssd1306->buffer[buffer_index + 6] & inv_bitmask) | ((src_byte & (1u << 6)) ? bitmask : 0u);
-            ssd1306->buffer[buffer_index + 7] = (ssd1306->buffer[buffer_index + 7] & inv_bitmask) | ((src_byte & (1u << 7)) ? bitmask : 0u);
+            const uint8_t src_byte = ssd1306_fetch_source_byte(src_row, src_byte_idx, shift, src_row_bytes);
+            uint8_t* out = dst + (src_byte_idx << 3);
+            if (mask_row != NULL) {
+                const uint8_t mask_byte = ssd1306_fetch_source_byte(mask_row, src_byte_idx, shift, src_row_bytes);
+                if (mask_byte == 0x00) {
+                    continue; // Transparent chunk, common around icons.
+                }
+                if (mask_byte != 0xFF) {
+                    // Partly opaque chunk: select the framebuffer bit of every opaque pixel without branches.
+                    for (uint8_t bit = 0; bit < 8; bit++) {
+                        const uint8_t opaque = (uint8_t)(0u - ((mask_byte >> bit) & 1u)) & bitmask;
+                        out[bit] = (out[bit] & (uint8_t)~opaque) | ((uint8_t)(0u - ((src_byte >> bit) & 1u)) & opaque);
+                    }
+                    continue;
+                }
+            }
+            out[0] = (out[0] & inv_bitmask) | ((src_byte & (1u << 0)) ? bitmask : 0u);
+            out[1] = (out[1] & inv_bitmask) | ((src_byte & (1u << 1)) ? bitmask : 0u);
+            out[2] = (out[2] & inv_bitmask) | ((src_byte & (1u << 2)) ? bitmask : 0u);
+            out[3] = (out[3] & inv_bitmask) | ((src_byte & (1u << 3)) ? bitmask : 0u);
+            out[4] = (out[4] & inv_bitmask) | ((src_byte & (1u << 4)) ? bitmask : 0u);
+            out[5] = (out[5] & inv_bitmask) | ((src_byte & (1u << 5)) ? bitmask : 0u);
+            out[6] = (out[6] & inv_bitmask) | ((src_byte & (1u << 6)) ? bitmask : 0u);
+            out[7] = (out[7] & inv_bitmask) | ((src_byte & (1u << 7)) ? bitmask : 0u);
         }
 
         // Handle the last partial byte when width is not aligned to 8 pixels.
         if (tail_bits != 0) {
-            const uint16_t tail_byte_index = row_base + full_bytes;
-            const uint8_t src_byte = bitmap_data[tail_byte_index];
-            const uint16_t tail_buffer_base = buffer_row_base + (full_bytes << 3);
+            const uint8_t src_byte = ssd1306_fetch_source_byte(src_row, full_bytes, shift, src_row_bytes);
+            const uint8_t mask_byte = (mask_row != NULL) ? ssd1306_fetch_source_byte(mask_row, full_bytes, shift, src_row_bytes) : 0xFF;
+            uint8_t* out = dst + (full_bytes << 3);
 
             for (uint16_t bit = 0; bit < tail_bits; bit++) {
-                const uint16_t buffer_index = tail_buffer_base + bit;
-                const uint8_t on_mask = (uint8_t)((src_byte & (1u << bit)) ? bitmask : 0u);
-                ssd1306->buffer[buffer_index] = (ssd1306->buffer[buffer_index] & inv_bitmask) | on_mask;
+                if (mask_byte & (1u << bit)) {
+                    const uint8_t on_mask = (uint8_t)((src_byte & (1u << bit)) ? bitmask : 0u);
+                    out[bit] = (out[bit] & inv_bitmask) | on_mask;
+                }
             }
         }
     }
 
+    _ssd1306_mark_dirty_area(ssd1306, (uint8_t)x0, (uint8_t)y0, draw_width, draw_height);
+
     return true;
 }
 
-bool ssd1306_draw_bitmap(ssd1306_t* ssd1306, const bitmap_t* bitmap, uint8_t start_x, uint8_t start_y) {
-    if (!ssd1306_is_ready(ssd1306) || bitmap == NULL || bitmap->data == NULL) {
-        return false;
+// Sequential reader of page data, raw or PackBits-compressed
+typedef struct {
+    const uint8_t* data;
+    bool compressed;
+    uint8_t run; // Bytes left in the current PackBits run
+    bool repeat; // Current run repeats one byte
+} ssd1306_page_reader_t;
+
+static inline uint8_t ssd1306_page_reader_next(ssd1306_page_reader_t* reader) {
+    if (!reader->compressed) {
+        return *reader->data++;
+    }
+    while (reader->run == 0) {
+        const uint8_t header = *reader->data++;
+        if (header < 0x80) { // Literal run of header + 1 bytes
+            reader->run = header + 1;
+            reader->repeat = false;
+        } else if (header > 0x80) { // Next byte repeated 257 - header times
+            reader->run = (uint8_t)(257 - header);
+            reader->repeat = true;
+        }
     }
-    return _ssd1306_draw_bitmap_internal(ssd1306, bitmap->data, 0, bitmap->width, bitmap->height, start_x, start_y);
+    reader->run--;
+    if (reader->repeat) {
+        return (reader->run == 0) ? *reader->data++ : *reader->data;
+    }
+    return *reader->data++;
 }
 
-void ssd1306_set_font(ssd1306_t* ssd1306, const font_t* font) {
-    if (ssd1306 == NULL) {
-        return;
+/**
+ * Store one source column byte, shifted into its two framebuffer pages, where both rows_* and opaque allow
+*/
+static inline void ssd1306_store_page_column(uint8_t* dst_low, uint8_t* dst_high, int16_t x, uint8_t value, uint8_t opaque, uint8_t shift, uint8_t rows_low, uint8_t rows_high) {
+    const uint16_t shifted = (uint16_t)value << shift;
+    const uint16_t shifted_opaque = (uint16_t)opaque << shift;
+    if (dst_low != NULL) {
+        const uint8_t store = rows_low & (uint8_t)shifted_opaque;
+        dst_low[x] = (dst_low[x] & (uint8_t)~store) | ((uint8_t)shifted & store);
+    }
+    if (dst_high != NULL) {
+        const uint8_t store = rows_high & (uint8_t)(shifted_opaque >> 8);
+        dst_high[x] = (dst_high[x] & (uint8_t)~store) | ((uint8_t)(shifted >> 8) & store);
     }
-    ssd1306->font = font;
 }
 
-bool ssd1306_print(ssd1306_t* ssd1306, const char* text, uint8_t start_x, uint8_t start_y) {
-    if (!ssd1306_is_ready(ssd1306)) {
+/**
+ * Draw a page-native image (BITMAP_FORMAT_PAGES or BITMAP_FORMAT_PAGES_RLE). Each source byte is
+ * 8 vertical pixels, so a page-aligned image is copied column by column; otherwise every byte
+ * is shifted across two framebuffer pages. Uncompressed pages are only read inside the clip
+ * rectangle, so a small clip cuts a sub-rectangle out of a large sheet cheaply.
+ * @param mask optional image of the same layout and compression, 1 = draw the pixel, 0 = keep the framebuffer
+ * @param start_x, start_y destination, may be negative
+*/
+bool _ssd1306_blit_pages(ssd1306_t* ssd1306, const uint8_t* data, const uint8_t* mask, bool compressed, uint16_t width, uint16_t height, int16_t start_x, int16_t start_y) {
+    if (!ssd1306_is_ready(ssd1306) || data == NULL || width == 0 || height == 0) {
         return false;
     }
-    const font_t* font = ssd1306->font;
-    if (font == NULL || text == NULL) {
-        return false;
+
+    const int16_t x0 = start_x > ssd1306->clip_x0 ? start_x : ssd1306->clip_x0;
+    const int16_t y0 = start_y > ssd1306->clip_y0 ? start_y : ssd1306->clip_y0;
+    const int16_t x1 = (start_x + (int16_t)width) < ssd1306->clip_x1 ? (start_x + (int16_t)width) : ssd1306->clip_x1;
+    const int16_t y1 = (start_y + (int16_t)height) < ssd1306->clip_y1 ? (start_y + (int16_t)height) : ssd1306->clip_y1;
+    if (x0 >= x1 || y0 >= y1) {
+        return true;
     }
 
-    uint8_t current_x = start_x;
-    uint16_t codepoint;
+    ssd1306_page_reader_t reader = { .data = data, .compressed = compressed };
+    ssd1306_page_reader_t mask_reader = { .data = mask, .compressed = compressed };
+    const uint16_t source_pages = (height + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN;
+    // Source rows that land in [y0, y1), relative to start_y.
+    const int16_t visible_top = y0 - start_y;
+    const int16_t visible_bottom = y1 - start_y;
+    // Offset of start_y into its framebuffer page, also for negative start_y (floor division).
+    const uint8_t shift = (uint8_t)(start_y & 0x07);
+    const int16_t first_page = (int16_t)((start_y - shift) / SSD1306_BITS_PER_COLUMN);
+
+    for (uint16_t source_page = 0; source_page < source_pages; source_page++) {
+        const int16_t row = (int16_t)(source_page * SSD1306_BITS_PER_COLUMN);
+        if (row >= visible_bottom) {
+            break; // Nothing below is visible and the reader does not need to advance further.
+        }
 
-    while (*text != '\0') {
-        if (current_x >= ssd1306->width) {
-            break;
+        // Rows of this source page to store, as a mask over its 8 bits.
+        uint8_t rows = 0xFF;
+        if (visible_top > row) {
+            rows = (visible_top - row >= 8) ? 0 : (uint8_t)(rows << (visible_top - row));
+        }
+        if (visible_bottom - row < 8) {
+            rows &= (uint8_t)((1u << (visible_bottom - row)) - 1);
         }
 
-        uint8_t first_byte = (uint8_t)*text;
-        int bytes_to_advance = 1; // Default to 1 byte for ASCII or error
+        const uint16_t rows_mask = (uint16_t)rows << shift;
+        const uint8_t rows_low = (uint8_t)rows_mask;
+        const uint8_t rows_high = (uint8_t)(rows_mask >> 8);
+        const int16_t page = first_page + (int16_t)source_page;
+        uint8_t* dst_low = (rows_low != 0) ? ssd1306->buffer + 1 + ((page - ssd1306->buffer_page) * ssd1306->width) : NULL;
+        uint8_t* dst_high = (rows_high != 0) ? ssd1306->buffer + 1 + ((page + 1 - ssd1306->buffer_page) * ssd1306->width) : NULL;
 
-        if (first_byte < 0x80) { // 1-byte ASCII character
-            codepoint = first_byte;
-        } else if ((first_byte & 0xE0) == 0xC0) { // 2-byte UTF-8 sequence (U+0080 to U+07FF)
-            if (*(text + 1) == '\0') { // Incomplete sequence
-                break;
-            }
-            uint8_t second_byte = (uint8_t)*(text + 1);
-            if ((second_byte & 0xC0) != 0x80) { // Invalid second byte
-                codepoint = '?'; // Placeholder
-            } else {
-                codepoint = ((first_byte & 0x1F) << 6) | (second_byte & 0x3F);
-                bytes_to_advance = 2;
-            }
-        } else if ((first_byte & 0xF0) == 0xE0) { // 3-byte UTF-8 sequence (U+0800 to U+FFFF)
-            if (*(text + 1) == '\0' || *(text + 2) == '\0') { // Incomplete sequence
-                break;
+        if (!compressed) {
+            if (rows == 0) {
+                continue;
             }
-            uint8_t second_byte = (uint8_t)*(text + 1);
-            uint8_t third_byte = (uint8_t)*(text + 2);
-            if (((second_byte & 0xC0) != 0x80) || ((third_byte & 0xC0) != 0x80)) { // Invalid bytes
-                codepoint = '?'; // Placeholder
-            } else {
-                codepoint = ((first_byte & 0x0F) << 12) | ((second_byte & 0x3F) << 6) | (third_byte & 0x3F);
-                bytes_to_advance = 3;
+            const uint32_t offset = (uint32_t)source_page * width + (uint16_t)(x0 - start_x);
+            if (mask == NULL && rows == 0xFF && shift == 0) {
+                // Page-aligned: the source row is the framebuffer row.
+                memcpy(dst_low + x0, data + offset, x1 - x0);
+                continue;
             }
-        } else if ((first_byte & 0xF8) == 0xF0) { // 4-byte UTF-8 sequence (U+10000 to U+10FFFF)
-            // Codepoints above U+FFFF cannot be represented by uint16_t, so we'll treat them as unsupported
-            if (*(text + 1) == '\0' || *(text + 2) == '\0' || *(text + 3) == '\0') { // Incomplete sequence
-                break;
+            const uint8_t* source = data + offset;
+            const uint8_t* source_mask = (mask != NULL) ? mask + offset : NULL;
+            for (int16_t x = x0; x < x1; x++) {
+                ssd1306_store_page_column(dst_low, dst_high, x, *source++, (source_mask != NULL) ? *source_mask++ : 0xFF, shift, rows_low, rows_high);
             }
-            // For 4-byte UTF-8, we advance the pointer but use a placeholder as uint16_t cannot hold it.
-            codepoint = '?'; 
-            bytes_to_advance = 4;
-        } else { // Invalid UTF-8 start byte or other unsupported sequences
-            codepoint = '?'; // Placeholder for invalid character
-        }
-
-        // Advance text pointer
-        text += bytes_to_advance;
-
-        if (codepoint == ' ') {
-            current_x += font->word_spacing;
             continue;
         }
 
-        uint8_t width = font->width; // Default width
-        bool symbol_found = false;
-
-        for (size_t i = 0; i < font->subsets_count; i++) {
-            const font_subset_t* subset = &font->subsets[i];
-            if (codepoint >= subset->start && codepoint <= subset->end) {
-                size_t char_index = codepoint - subset->start;
-                if (char_index < subset->symbols_count) {
-                    uint32_t offset = subset->offsets[char_index];
-                    if (subset->widths) { // Variable width font
-                        width = subset->widths[char_index];
-                    }
-
-                    if (!_ssd1306_draw_bitmap_internal(ssd1306, subset->symbols, offset, width, font->height, current_x, start_y)) {
-                        return false; // Stop if drawing fails
-                    }
-                    symbol_found = true;
-                }
-                break;
+        // Compressed pages are decoded in order, including the columns outside the clip.
+        for (int16_t x = start_x; x < start_x + (int16_t)width; x++) {
+            const uint8_t value = ssd1306_page_reader_next(&reader);
+            const uint8_t opaque = (mask != NULL) ? ssd1306_page_reader_next(&mask_reader) : 0xFF;
+            if (x < x0 || x >= x1 || rows == 0) {
+                continue;
             }
+            ssd1306_store_page_column(dst_low, dst_high, x, value, opaque, shift, rows_low, rows_high);
         }
-        
-        // If symbol not found, and it's not a placeholder already,
-        // you might want to print a default '?' or skip advancement.
-        // For now, we always advance current_x.
-        current_x += width + font->letter_spacing;
     }
 
+    _ssd1306_mark_dirty_area(ssd1306, (uint8_t)x0, (uint8_t)y0, (uint16_t)(x1 - x0), (uint16_t)(y1 - y0));
     return true;
 }
 
-bool ssd1306_show(ssd1306_t* ssd1306) {
-    if (!ssd1306_is_ready(ssd1306)) {
+/**
+ * Streaming mode: append a draw call to the display list and mark its clipped bounds dirty.
+ * @return false if the display list is full
+*/
+static bool ssd1306_display_list_record(ssd1306_t* ssd1306, ssd1306_display_list_op_t op, const void* source, uint8_t x, uint8_t y, uint8_t width, uint8_t height, const char* text, size_t text_length) {
+    const size_t alignment = _Alignof(ssd1306_display_list_entry_t);
+    const size_t text_size = (text != NULL) ? ((text_length + 1 + alignment - 1) & ~(alignment - 1)) : 0;
+    if (ssd1306->display_list_size + sizeof(ssd1306_display_list_entry_t) + text_size > ssd1306->display_list_capacity) {
         return false;
     }
 
-    const uint8_t pages = ssd1306->height / SSD1306_BITS_PER_COLUMN;
-
-    if (!ssd1306_send_command_value(ssd1306, SSD1306_MEMORY_ADDRESSING_MODE_COMMAND, SSD1306_MEMORY_ADDRESSING_MODE_PAGE)) {
-        return false;
+    ssd1306_display_list_entry_t* entry = (ssd1306_display_list_entry_t*)(ssd1306->display_list + ssd1306->display_list_size);
+    entry->op = (uint8_t)op;
+    entry->x = x;
+    entry->y = y;
+    entry->clip_x0 = ssd1306->clip_x0;
+    entry->clip_y0 = ssd1306->clip_y0;
+    entry->clip_x1 = ssd1306->clip_x1;
+    entry->clip_y1 = ssd1306->clip_y1;
+    entry->text_scale = ssd1306->text_scale;
+    entry->text_bold = ssd1306->text_bold;
+    entry->text_size = (uint16_t)text_size;
+    entry->source = source;
+    if (text != NULL) {
+        memcpy((char*)(entry + 1), text, text_length);
+        ((char*)(entry + 1))[text_length] = '\0';
+    }
+    ssd1306->display_list_size += (uint16_t)(sizeof(ssd1306_display_list_entry_t) + text_size);
+
+    const uint8_t x0 = x > ssd1306->clip_x0 ? x : ssd1306->clip_x0;
+    const uint8_t y0 = y > ssd1306->clip_y0 ? y : ssd1306->clip_y0;
+    const uint8_t x1 = ((uint16_t)x + width) < ssd1306->clip_x1 ? (uint8_t)(x + width) : ssd1306->clip_x1;
+    const uint8_t y1 = ((uint16_t)y + height) < ssd1306->clip_y1 ? (uint8_t)(y + height) : ssd1306->clip_y1;
+    if (x0 < x1 && y0 < y1) {
+        _ssd1306_mark_dirty_area(ssd1306, x0, y0, x1 - x0, y1 - y0);
     }
+    return true;
+}
 
-    uint8_t tx[1 + 128];
-    tx[0] = SSD1306_SEND_DATA;
+static bool _ssd1306_draw_bitmap_internal(ssd1306_t* ssd1306, const uint8_t* bitmap, uint32_t offset, uint8_t format, uint8_t width, uint8_t height, int16_t start_x, int16_t start_y) {
+    SSD1306_STATS_TIME_BEGIN(begin);
+    bool is_ok;
+    if (format == BITMAP_FORMAT_ROWS) {
+        is_ok = _ssd1306_blit_rect(ssd1306, &bitmap[offset], NULL, (width + 7) / 8, 0, 0, width, height, start_x, start_y);
+    } else {
+        is_ok = _ssd1306_blit_pages(ssd1306, &bitmap[offset], NULL, format == BITMAP_FORMAT_PAGES_RLE, width, height, start_x, start_y);
+    }
+    SSD1306_STATS_TIME_END(ssd1306, blit, begin);
+    return is_ok;
+}
+
+bool ssd1306_draw_bitmap(ssd1306_t* ssd1306, const bitmap_t* bitmap, uint8_t start_x, uint8_t start_y) {
+    if (!ssd1306_is_ready(ssd1306) || bitmap == NULL || bitmap->data == NULL) {
+        return false;
+    }
+    bitmap = ssd1306_resolve_resident(ssd1306, bitmap);
+    if (ssd1306->display_list != NULL) {
+        return ssd1306_display_list_record(ssd1306, SSD1306_DISPLAY_LIST_BITMAP, bitmap, start_x, start_y, bitmap->width, bitmap->height, NULL, 0);
+    }
+    return _ssd1306_draw_bitmap_internal(ssd1306, bitmap->data, 0, bitmap->format, bitmap->width, bitmap->height, start_x, start_y);
+}
+
+/**
+ * Draw the sub-rectangle of a bitmap at [src_x, src_x + width) x [src_y, src_y + height).
+ * Rows images go straight to the rectangle blit. Page images are drawn whole at the offset
+ * position with the clip narrowed to the destination, so only the columns of the rectangle are read.
+*/
+static bool ssd1306_draw_bitmap_rect_internal(ssd1306_t* ssd1306, const bitmap_t* bitmap, const uint8_t* mask, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y) {
+    SSD1306_STATS_TIME_BEGIN(begin);
+    bool is_ok = true;
+    if (bitmap->format == BITMAP_FORMAT_ROWS) {
+        is_ok = _ssd1306_blit_rect(ssd1306, bitmap->data, mask, (bitmap->width + 7) / 8, src_x, src_y, width, height, start_x, start_y);
+    } else {
+        const uint8_t clip[] = { ssd1306->clip_x0, ssd1306->clip_y0, ssd1306->clip_x1, ssd1306->clip_y1 };
+        const uint16_t end_x = (uint16_t)start_x + width;
+        const uint16_t end_y = (uint16_t)start_y + height;
+        ssd1306->clip_x0 = start_x > clip[0] ? start_x : clip[0];
+        ssd1306->clip_y0 = start_y > clip[1] ? start_y : clip[1];
+        ssd1306->clip_x1 = end_x < clip[2] ? (uint8_t)end_x : clip[2];
+        ssd1306->clip_y1 = end_y < clip[3] ? (uint8_t)end_y : clip[3];
+        if (ssd1306->clip_x0 < ssd1306->clip_x1 && ssd1306->clip_y0 < ssd1306->clip_y1) {
+            is_ok = _ssd1306_blit_pages(ssd1306, bitmap->data, mask, bitmap->format == BITMAP_FORMAT_PAGES_RLE, bitmap->width, bitmap->height,
+                                        (int16_t)start_x - src_x, (int16_t)start_y - src_y);
+        }
+        ssd1306->clip_x0 = clip[0];
+        ssd1306->clip_y0 = clip[1];
+        ssd1306->clip_x1 = clip[2];
+        ssd1306->clip_y1 = clip[3];
+    }
+    SSD1306_STATS_TIME_END(ssd1306, blit, begin);
+    return is_ok;
+}
+
+/**
+ * Draw a sub-rectangle of a bitmap, e.g. one icon of a sheet
+ * @param ssd1306
+ * @param bitmap
+ * @param src_x, src_y, width, height Rectangle inside the bitmap
+ * @param start_x, start_y Destination of its top left corner
+*/
+bool ssd1306_draw_bitmap_rect(ssd1306_t* ssd1306, const bitmap_t* bitmap, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y) {
+    return ssd1306_draw_bitmap_masked(ssd1306, bitmap, NULL, src_x, src_y, width, height, start_x, start_y);
+}
+
+/**
+ * Draw a sub-rectangle of a bitmap through a 1bpp mask: pixels where the mask is 0 keep the framebuffer.
+ * Fully transparent and fully opaque mask bytes take the plain copy paths, only mixed ones are merged bit by bit.
+ * @param mask Same layout, size and compression as bitmap->data, 1 = opaque; NULL draws every pixel
+ * @return false if the rectangle is empty or outside the bitmap, or the display list is full
+*/
+bool ssd1306_draw_bitmap_masked(ssd1306_t* ssd1306, const bitmap_t* bitmap, const uint8_t* mask, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y) {
+    if (!ssd1306_is_ready(ssd1306) || bitmap == NULL || bitmap->data == NULL || width == 0 || height == 0 ||
+        (uint16_t)src_x + width > bitmap->width || (uint16_t)src_y + height > bitmap->height) {
+        return false;
+    }
+    // A caller mask matches the layout of the flash bitmap, so a copy converted to pages is not used with it.
+    const bitmap_t* resident = ssd1306_resolve_resident(ssd1306, bitmap);
+    if (mask == NULL || resident->format == bitmap->format) {
+        bitmap = resident;
+    }
+    if (ssd1306->display_list != NULL) {
+        const ssd1306_display_list_rect_t rect = { .mask = mask, .src_x = src_x, .src_y = src_y, .width = width, .height = height };
+        return ssd1306_display_list_record(ssd1306, SSD1306_DISPLAY_LIST_BITMAP_RECT, bitmap, start_x, start_y, width, height, (const char*)&rect, sizeof(rect));
+    }
+    return ssd1306_draw_bitmap_rect_internal(ssd1306, bitmap, mask, src_x, src_y, width, height, start_x, start_y);
+}
+
+/**
+ * Draw one icon of an atlas, through the atlas mask if it has one
+ * @param index Entry of atlas->rects
+*/
+bool ssd1306_draw_atlas(ssd1306_t* ssd1306, const bitmap_atlas_t* atlas, uint16_t index, uint8_t start_x, uint8_t start_y) {
+    if (ssd1306 == NULL || atlas == NULL || atlas->rects == NULL || index >= atlas->rects_count) {
+        return false;
+    }
+    atlas = ssd1306_resolve_resident(ssd1306, atlas);
+    const bitmap_rect_t* rect = &atlas->rects[index];
+    return ssd1306_draw_bitmap_masked(ssd1306, &atlas->sheet, atlas->mask, rect->x, rect->y, rect->width, rect->height, start_x, start_y);
+}
+
+// Bayer 8x8 ordered-dither matrix, values 0-63
+static const uint8_t ssd1306_bayer_8x8[8][8] = {
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 },
+};
 
+/**
+ * Dither one source row into bit `bit` of the page strip.
+ * The matrix is anchored to display coordinates, so the pattern does not crawl when the image moves.
+*/
+static void ssd1306_dither_row_bayer(const uint8_t* src, uint8_t columns, uint8_t start_x, uint8_t y, uint8_t bit, uint8_t* strip) {
+    const uint8_t* matrix_row = ssd1306_bayer_8x8[y & 0x07];
+    uint8_t thresholds[8];
+    for (uint8_t i = 0; i < 8; i++) {
+        // Pixel is on when value >= 4 * M + 2: 0 is always off, 255 always on.
+        thresholds[i] = (uint8_t)(matrix_row[(start_x + i) & 0x07] * 4 + 1);
+    }
+    for (uint8_t x = 0; x < columns; x++) {
+        if (src[x] > thresholds[x & 0x07]) {
+            strip[x] |= bit;
+        }
+    }
+}
+
+/**
+ * Floyd-Steinberg with a single row of errors: errors[x + 1] holds the error diffused into
+ * this row at x and is replaced by the error for the next row once x is consumed.
+*/
+static void ssd1306_dither_row_floyd_steinberg(const uint8_t* src, uint8_t columns, int16_t* errors, uint8_t bit, uint8_t* strip) {
+    int16_t right = 0; // 7/16 to x + 1 in this row
+    int16_t below_right = 0; // 1/16 from x - 1 to x in the next row
+    errors[0] = 0;
+    for (uint8_t x = 0; x < columns; x++) {
+        const int16_t value = (int16_t)src[x] + errors[x + 1] + right;
+        int16_t error = value;
+        if (value >= 128) {
+            strip[x] |= bit;
+            error = value - 255;
+        }
+        right = (int16_t)((error * 7) >> 4);
+        errors[x] += (int16_t)((error * 3) >> 4);
+        errors[x + 1] = (int16_t)(((error * 5) >> 4) + below_right);
+        below_right = (int16_t)(error >> 4);
+    }
+}
+
+/**
+ * Atkinson: 1/8 of the error to x + 1 and x + 2, to x - 1, x and x + 1 in the next row and to x
+ * two rows down. It reaches two rows ahead, so it needs a second row of errors: current[x + 1]
+ * is replaced by the error for two rows down once consumed, then the caller swaps the rows.
+*/
+static void ssd1306_dither_row_atkinson(const uint8_t* src, uint8_t columns, int16_t* current, int16_t* next, uint8_t bit, uint8_t* strip) {
+    int16_t right = 0; // Error for x + 1 in this row
+    int16_t right_2 = 0; // Error for x + 2 in this row
+    next[0] = 0;
+    for (uint8_t x = 0; x < columns; x++) {
+        const int16_t value = (int16_t)src[x] + current[x + 1] + right;
+        int16_t error = value;
+        if (value >= 128) {
+            strip[x] |= bit;
+            error = value - 255;
+        }
+        const int16_t part = (int16_t)(error >> 3);
+        right = right_2 + part;
+        right_2 = part;
+        next[x] += part;
+        next[x + 1] += part;
+        next[x + 2] += part;
+        current[x + 1] = part;
+    }
+    current[columns + 1] = 0;
+}
+
+/**
+ * Draw an 8-bit grayscale image (0 = off, 255 = on), dithered to 1 bit per pixel.
+ * Rows are dithered top to bottom into a page strip that is stored with one byte write per column.
+ * Not available in page-streaming mode.
+ * @param pixels First pixel of the image
+ * @param stride Bytes between the starts of two rows (>= width)
+ * @param dither Dithering method
+*/
+bool ssd1306_draw_gray(ssd1306_t* ssd1306, const uint8_t* pixels, uint16_t stride, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y, ssd1306_dither_t dither) {
+    if (!ssd1306_is_ready(ssd1306) || ssd1306->display_list != NULL || pixels == NULL || width == 0 || height == 0 || stride < width) {
+        return false;
+    }
+    if (dither != SSD1306_DITHER_BAYER && dither != SSD1306_DITHER_FLOYD_STEINBERG && dither != SSD1306_DITHER_ATKINSON) {
+        return false;
+    }
+
+    // Columns past the display edge are not dithered; rows below the clip cannot affect visible rows.
+    const uint8_t x1 = ((uint16_t)start_x + width) < ssd1306->width ? (uint8_t)(start_x + width) : ssd1306->width;
+    const uint8_t y1 = ((uint16_t)start_y + height) < ssd1306->clip_y1 ? (uint8_t)(start_y + height) : ssd1306->clip_y1;
+    const uint8_t write_x0 = start_x > ssd1306->clip_x0 ? start_x : ssd1306->clip_x0;
+    const uint8_t write_x1 = x1 < ssd1306->clip_x1 ? x1 : ssd1306->clip_x1;
+    const uint8_t write_y0 = start_y > ssd1306->clip_y0 ? start_y : ssd1306->clip_y0;
+    if (write_x0 >= write_x1 || write_y0 >= y1) {
+        return true;
+    }
+
+    SSD1306_STATS_TIME_BEGIN(begin);
+    const uint8_t columns = x1 - start_x;
+    int16_t errors[2][SSD1306_WIDTH_MAX + 3] = {};
+    int16_t* current = errors[0];
+    int16_t* next = errors[1];
+    uint8_t strip[SSD1306_WIDTH_MAX] = {};
+    uint8_t strip_rows = 0; // Rows of the current page to store
+
+    for (uint8_t y = start_y; y < y1; y++) {
+        const uint8_t* src = pixels + (uint32_t)(y - start_y) * stride;
+        const uint8_t bit = (uint8_t)(1u << (y & 0x07));
+
+        switch (dither) {
+            case SSD1306_DITHER_BAYER:
+                ssd1306_dither_row_bayer(src, columns, start_x, y, bit, strip);
+                break;
+            case SSD1306_DITHER_FLOYD_STEINBERG:
+                ssd1306_dither_row_floyd_steinberg(src, columns, current, bit, strip);
+                break;
+            case SSD1306_DITHER_ATKINSON: {
+                ssd1306_dither_row_atkinson(src, columns, current, next, bit, strip);
+                int16_t* swap = current;
+                current = next;
+                next = swap;
+                break;
+            }
+        }
+
+        if (y >= write_y0) {
+            strip_rows |= bit;
+        }
+        if ((y & 0x07) != 0x07 && y != y1 - 1) {
+            continue;
+        }
+
+        // Page complete: merge the strip into the framebuffer, keeping rows outside the image and clip.
+        if (strip_rows != 0) {
+            const uint8_t page = y / SSD1306_BITS_PER_COLUMN;
+            uint8_t* dst = ssd1306->buffer + 1 + ((page - ssd1306->buffer_page) * ssd1306->width) + write_x0;
+            const uint8_t* packed = strip + (write_x0 - start_x);
+            const uint8_t keep = (uint8_t)~strip_rows;
+            for (uint8_t x = 0; x < write_x1 - write_x0; x++) {
+                dst[x] = (dst[x] & keep) | (packed[x] & strip_rows);
+            }
+        }
+        memset(strip, 0, columns);
+        strip_rows = 0;
+    }
+
+    _ssd1306_mark_dirty_area(ssd1306, write_x0, write_y0, write_x1 - write_x0, y1 - write_y0);
+    SSD1306_STATS_TIME_END(ssd1306, blit, begin);
+    return true;
+}
+
+void ssd1306_set_font(ssd1306_t* ssd1306, const font_t* font) {
+    if (ssd1306 == NULL) {
+        return;
+    }
+    ssd1306->font = font;
+}
+
+/**
+ * Magnify the glyphs of the current font for the following print calls
+ * @param ssd1306
+ * @param scale 1 (native size) to SSD1306_TEXT_SCALE_MAX, needs a font at most SSD1306_STYLED_GLYPH_HEIGHT_MAX pixels high
+ * @return false if scale is out of range
+*/
+bool ssd1306_set_text_scale(ssd1306_t* ssd1306, uint8_t scale) {
+    if (ssd1306 == NULL || scale == 0 || scale > SSD1306_TEXT_SCALE_MAX) {
+        return false;
+    }
+    ssd1306->text_scale = scale;
+    return true;
+}
+
+/**
+ * Synthesize bold glyphs for the following print calls: each glyph is drawn over itself one
+ * pixel to the right and advances one pixel more.
+*/
+void ssd1306_set_text_bold(ssd1306_t* ssd1306, bool bold) {
+    if (ssd1306 == NULL) {
+        return;
+    }
+    ssd1306->text_bold = bold;
+}
+
+/**
+ * Decode the UTF-8 sequence at *text and advance past it.
+ * Overlong forms, surrogates, codepoints above U+10FFFF and truncated sequences give
+ * SSD1306_UTF8_REPLACEMENT and skip only the bytes of the broken sequence.
+ * @param text
+ * @return Codepoint, 0 at the terminating NUL (text is not advanced then)
+*/
+uint32_t ssd1306_utf8_next(const char** text) {
+    const uint8_t* bytes = (const uint8_t*)*text;
+    const uint8_t lead = bytes[0];
+    if (lead < 0x80) {
+        *text += (lead != 0);
+        return lead;
+    }
+
+    // Allowed range of the second byte excludes overlong forms, surrogates and values above U+10FFFF.
+    uint8_t length;
+    uint32_t codepoint;
+    uint8_t low = 0x80;
+    uint8_t high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        codepoint = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        codepoint = lead & 0x0F;
+        low = (lead == 0xE0) ? 0xA0 : low;
+        high = (lead == 0xED) ? 0x9F : high;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        codepoint = lead & 0x07;
+        low = (lead == 0xF0) ? 0x90 : low;
+        high = (lead == 0xF4) ? 0x8F : high;
+    } else { // Continuation byte or lead byte that cannot start a valid sequence
+        *text += 1;
+        return SSD1306_UTF8_REPLACEMENT;
+    }
+
+    for (uint8_t i = 1; i < length; i++) {
+        const uint8_t byte = bytes[i];
+        if (byte < low || byte > high) { // Also stops at the terminating NUL
+            *text += i;
+            return SSD1306_UTF8_REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (byte & 0x3F);
+        low = 0x80;
+        high = 0xBF;
+    }
+    *text += length;
+    return codepoint;
+}
+
+/**
+ * Length of the run of ASCII characters at the start of text[0, length), checked a word at a time
+*/
+static size_t ssd1306_utf8_ascii_run(const char* text, size_t length) {
+    size_t run = 0;
+    while (run < length && ((uintptr_t)(text + run) & (sizeof(uint32_t) - 1)) != 0) {
+        if ((uint8_t)text[run] >= 0x80) {
+            return run;
+        }
+        run++;
+    }
+    while (length - run >= sizeof(uint32_t)) {
+        uint32_t word;
+        memcpy(&word, __builtin_assume_aligned(text + run, sizeof(uint32_t)), sizeof(word));
+        if (word & 0x80808080u) {
+            break;
+        }
+        run += sizeof(word);
+    }
+    while (run < length && (uint8_t)text[run] < 0x80) {
+        run++;
+    }
+    return run;
+}
+
+/**
+ * Index of the glyph for a codepoint inside subset->start..end, symbols_count if there is none
+*/
+static size_t ssd1306_find_glyph_index(const font_subset_t* subset, uint32_t codepoint) {
+    if (subset->codepoints == NULL) {
+        return codepoint - subset->start;
+    }
+    size_t low = 0;
+    size_t high = subset->symbols_count;
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        if (subset->codepoints[middle] < codepoint) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return (low < subset->symbols_count && subset->codepoints[low] == codepoint) ? low : subset->symbols_count;
+}
+
+/**
+ * Find the glyph of a codepoint. Only the first subset whose start..end holds it is searched.
+ * @return Subset holding the glyph and its index in *index, NULL if the font has no glyph for it
+*/
+static const font_subset_t* ssd1306_find_glyph(const font_t* font, uint32_t codepoint, size_t* index) {
+    for (size_t i = 0; i < font->subsets_count; i++) {
+        const font_subset_t* subset = &font->subsets[i];
+        if (codepoint >= subset->start && codepoint <= subset->end) {
+            *index = ssd1306_find_glyph_index(subset, codepoint);
+            return (*index < subset->symbols_count) ? subset : NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Advance of a glyph at the current text scale and weight, letter spacing excluded
+*/
+static uint16_t ssd1306_glyph_width(const ssd1306_t* ssd1306, uint32_t codepoint) {
+    const font_t* font = ssd1306->font;
+    size_t index;
+    const font_subset_t* subset = ssd1306_find_glyph(font, codepoint, &index);
+    const uint8_t width = (subset != NULL && subset->widths != NULL) ? subset->widths[index] : font->width;
+    return (uint16_t)width * ssd1306->text_scale + (ssd1306->text_bold ? 1 : 0);
+}
+
+static uint16_t ssd1306_letter_spacing(const ssd1306_t* ssd1306) {
+    return (uint16_t)ssd1306->font->letter_spacing * ssd1306->text_scale;
+}
+
+static uint16_t ssd1306_word_spacing(const ssd1306_t* ssd1306) {
+    return (uint16_t)ssd1306->font->word_spacing * ssd1306->text_scale;
+}
+
+static uint16_t ssd1306_text_height(const ssd1306_t* ssd1306) {
+    return (uint16_t)ssd1306->font->height * ssd1306->text_scale;
+}
+
+// Each bit of a nibble repeated 2, 3 and 4 times: one lookup widens 4 rows of a glyph column.
+static const uint16_t ssd1306_scale_lut[SSD1306_TEXT_SCALE_MAX - 1][16] = {
+    { 0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F, 0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF },
+    { 0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF, 0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF },
+    { 0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF },
+};
+
+/**
+ * Stretch a glyph column (bit n = row n) vertically by scale. Rows past the 64th cannot be on the display and are dropped.
+*/
+static uint64_t ssd1306_scale_column(uint32_t column, uint8_t scale) {
+    if (scale == 1) {
+        return column;
+    }
+    const uint16_t* lut = ssd1306_scale_lut[scale - 2];
+    uint64_t scaled = 0;
+    for (uint8_t row = 0; column != 0 && row * scale < 64; row += 4) {
+        scaled |= (uint64_t)lut[column & 0x0F] << (row * scale);
+        column >>= 4;
+    }
+    return scaled;
+}
+
+// Glyph columns converted per batch, bounds the stack use of wide glyphs
+#define SSD1306_GLYPH_COLUMNS_BATCH 32
+
+/**
+ * Read count columns of a glyph from column first on, as bit masks with bit n = row n
+*/
+static void ssd1306_read_glyph_columns(const uint8_t* data, uint8_t format, uint8_t width, uint8_t height, uint8_t first, uint8_t count, uint32_t* columns) {
+    memset(columns, 0, count * sizeof(columns[0]));
+    if (format == BITMAP_FORMAT_ROWS) {
+        const uint8_t row_bytes = (width + 7) / 8;
+        for (uint8_t row = 0; row < height; row++) {
+            const uint8_t* source = data + (uint16_t)row * row_bytes;
+            const uint32_t bit = 1u << row;
+            for (uint8_t i = 0; i < count; i++) {
+                const uint8_t x = first + i;
+                if (source[x >> 3] & (1u << (x & 0x07))) {
+                    columns[i] |= bit;
+                }
+            }
+        }
+        return;
+    }
+
+    const uint8_t pages = (height + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN;
+    if (format == BITMAP_FORMAT_PAGES) {
+        for (uint8_t page = 0; page < pages; page++) {
+            const uint8_t* source = data + (uint16_t)page * width + first;
+            for (uint8_t i = 0; i < count; i++) {
+                columns[i] |= (uint32_t)source[i] << (page * SSD1306_BITS_PER_COLUMN);
+            }
+        }
+        return;
+    }
+
+    // PackBits is only readable from the start, page after page.
+    ssd1306_page_reader_t reader = { .data = data, .compressed = true };
     for (uint8_t page = 0; page < pages; page++) {
-        if (!ssd1306_send_command(ssd1306, (uint8_t)(0xB0 | page))) {
+        for (uint8_t x = 0; x < width; x++) {
+            const uint8_t value = ssd1306_page_reader_next(&reader);
+            if ((uint8_t)(x - first) < count) {
+                columns[x - first] |= (uint32_t)value << (page * SSD1306_BITS_PER_COLUMN);
+            }
+        }
+    }
+}
+
+/**
+ * Store one output column of a styled glyph into the pages it covers
+ * @param column Pixels in display rows (bit n = row n)
+ * @param rows Visible rows of the glyph cell, they are overwritten
+*/
+static inline void ssd1306_store_glyph_column(ssd1306_t* ssd1306, uint8_t x, uint64_t column, uint64_t rows, uint8_t first_page, uint8_t last_page) {
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        const uint8_t shift = page * SSD1306_BITS_PER_COLUMN;
+        const uint8_t mask = (uint8_t)(rows >> shift);
+        uint8_t* out = ssd1306->buffer + 1 + (uint16_t)(page - ssd1306->buffer_page) * ssd1306->width + x;
+        *out = (*out & (uint8_t)~mask) | ((uint8_t)(column >> shift) & mask);
+    }
+}
+
+/**
+ * Draw a glyph at the current text scale and weight. A source column is widened a nibble at a
+ * time through ssd1306_scale_lut and stored a page byte at a time, so the cost is per output
+ * column, not per pixel. Bold ORs every output column with the one before it.
+ * The glyph may start left of or above the display, only its visible part is drawn.
+ * @return false if the font is higher than SSD1306_STYLED_GLYPH_HEIGHT_MAX
+*/
+static bool ssd1306_draw_glyph_styled(ssd1306_t* ssd1306, const uint8_t* data, uint8_t format, uint8_t width, uint8_t height, int16_t start_x, int16_t start_y) {
+    if (height > SSD1306_STYLED_GLYPH_HEIGHT_MAX) {
+        return false;
+    }
+    SSD1306_STATS_TIME_BEGIN(begin);
+    const uint8_t scale = ssd1306->text_scale;
+    const uint8_t bold = ssd1306->text_bold ? 1 : 0;
+    const int16_t cell_x1 = start_x + (int16_t)(width * scale) + bold;
+    const int16_t cell_y1 = start_y + (int16_t)(height * scale);
+    if (start_x >= ssd1306->clip_x1 || start_y >= ssd1306->clip_y1 || cell_x1 <= ssd1306->clip_x0 || cell_y1 <= ssd1306->clip_y0) {
+        return true;
+    }
+    const uint8_t x0 = start_x > ssd1306->clip_x0 ? (uint8_t)start_x : ssd1306->clip_x0;
+    const uint8_t y0 = start_y > ssd1306->clip_y0 ? (uint8_t)start_y : ssd1306->clip_y0;
+    const uint8_t x1 = cell_x1 < ssd1306->clip_x1 ? (uint8_t)cell_x1 : ssd1306->clip_x1;
+    const uint8_t y1 = cell_y1 < ssd1306->clip_y1 ? (uint8_t)cell_y1 : ssd1306->clip_y1;
+    if (x0 >= x1 || y0 >= y1) {
+        return true;
+    }
+
+    const uint8_t visible_rows = y1 - y0;
+    const uint64_t rows = (visible_rows >= 64 ? UINT64_MAX : ((1ull << visible_rows) - 1)) << y0;
+    const uint8_t first_page = y0 / SSD1306_BITS_PER_COLUMN;
+    const uint8_t last_page = (y1 - 1) / SSD1306_BITS_PER_COLUMN;
+
+    // Output columns [first_output, end_output) relative to start_x are visible. Bold needs the
+    // source column left of the first visible output column too.
+    const uint16_t first_output = x0 - start_x;
+    const uint16_t end_output = x1 - start_x;
+    const uint8_t first_source = (uint8_t)((first_output >= bold ? first_output - bold : 0) / scale);
+    const uint16_t source_end = (end_output + scale - 1) / scale;
+    const uint8_t end_source = source_end < width ? (uint8_t)source_end : width;
+
+    uint32_t columns[SSD1306_GLYPH_COLUMNS_BATCH];
+    uint64_t previous = 0;
+    uint16_t output = (uint16_t)first_source * scale;
+    for (uint8_t batch = first_source; batch < end_source; batch += SSD1306_GLYPH_COLUMNS_BATCH) {
+        const uint8_t count = (end_source - batch) < SSD1306_GLYPH_COLUMNS_BATCH ? end_source - batch : SSD1306_GLYPH_COLUMNS_BATCH;
+        ssd1306_read_glyph_columns(data, format, width, height, batch, count, columns);
+        for (uint8_t i = 0; i < count; i++) {
+            const uint64_t column = ssd1306_scale_column(columns[i], scale);
+            const uint64_t scaled = start_y >= 0 ? column << start_y : (start_y > -64 ? column >> -start_y : 0);
+            for (uint8_t repeat = 0; repeat < scale; repeat++, output++) {
+                if (output >= first_output && output < end_output) {
+                    ssd1306_store_glyph_column(ssd1306, (uint8_t)(start_x + output), bold ? scaled | previous : scaled, rows, first_page, last_page);
+                }
+                previous = scaled;
+            }
+        }
+    }
+    if (bold && output == (uint16_t)width * scale && output >= first_output && output < end_output) {
+        ssd1306_store_glyph_column(ssd1306, (uint8_t)(start_x + output), previous, rows, first_page, last_page);
+    }
+
+    _ssd1306_mark_dirty_area(ssd1306, x0, y0, x1 - x0, y1 - y0);
+    SSD1306_STATS_TIME_END(ssd1306, blit, begin);
+    return true;
+}
+
+/**
+ * Draw length bytes of text on one line, stopping early at the right edge.
+ * The line may start left of or above the display, glyphs outside it are skipped by the clip.
+*/
+static bool ssd1306_print_text(ssd1306_t* ssd1306, const char* text, size_t length, int16_t start_x, int16_t start_y) {
+    if (!ssd1306_is_ready(ssd1306)) {
+        return false;
+    }
+    const font_t* font = ssd1306->font;
+    if (font == NULL || text == NULL) {
+        return false;
+    }
+    font = ssd1306_resolve_resident(ssd1306, font);
+
+    const bool is_styled = ssd1306->text_scale > 1 || ssd1306->text_bold;
+    int16_t current_x = start_x;
+    size_t ascii_left = 0;
+
+    while (length > 0 && current_x < ssd1306->width) {
+        // ASCII runs are found a word at a time and then taken byte by byte without decoding.
+        uint32_t codepoint;
+        if (ascii_left == 0) {
+            ascii_left = ssd1306_utf8_ascii_run(text, length);
+        }
+        if (ascii_left > 0) {
+            codepoint = (uint8_t)*text++;
+            ascii_left--;
+            length--;
+        } else {
+            const char* next = text;
+            codepoint = ssd1306_utf8_next(&next);
+            if (codepoint == 0) {
+                break;
+            }
+            const size_t consumed = (size_t)(next - text);
+            length = (consumed < length) ? length - consumed : 0;
+            text = next;
+        }
+
+        if (codepoint == ' ') {
+            current_x += ssd1306_word_spacing(ssd1306);
+            continue;
+        }
+
+        uint8_t width = font->width; // Default width
+        size_t char_index;
+        const font_subset_t* subset = ssd1306_find_glyph(font, codepoint, &char_index);
+        if (subset != NULL) {
+            if (subset->widths) { // Variable width font
+                width = subset->widths[char_index];
+            }
+            const bool is_drawn = is_styled
+                ? ssd1306_draw_glyph_styled(ssd1306, &subset->symbols[subset->offsets[char_index]], font->format, width, font->height, current_x, start_y)
+                : _ssd1306_draw_bitmap_internal(ssd1306, subset->symbols, subset->offsets[char_index], font->format, width, font->height, current_x, start_y);
+            if (!is_drawn) {
+                return false; // Stop if drawing fails
+            }
+        }
+
+        // A codepoint without a glyph still advances by the default width.
+        current_x += (uint16_t)width * ssd1306->text_scale + (ssd1306->text_bold ? 1 : 0) + ssd1306_letter_spacing(ssd1306);
+    }
+
+    return true;
+}
+
+bool ssd1306_print(ssd1306_t* ssd1306, const char* text, uint8_t start_x, uint8_t start_y) {
+    if (ssd1306_is_ready(ssd1306) && ssd1306->display_list != NULL) {
+        if (ssd1306->font == NULL || text == NULL) {
             return false;
         }
-        if (!ssd1306_send_command(ssd1306, 0x00)) {
+        // Text runs to the right edge at most; its real width is only known when rasterized.
+        return ssd1306_display_list_record(ssd1306, SSD1306_DISPLAY_LIST_TEXT, ssd1306->font, start_x, start_y,
+                                           ssd1306->width - (start_x < ssd1306->width ? start_x : ssd1306->width), (uint8_t)ssd1306_text_height(ssd1306), text, strlen(text));
+    }
+    return _ssd1306_print_at(ssd1306, text, start_x, start_y);
+}
+
+/**
+ * Print text at a position that may be left of or above the display, e.g. text continuing
+ * from a neighbouring panel. Not recorded in page-streaming mode.
+*/
+bool _ssd1306_print_at(ssd1306_t* ssd1306, const char* text, int16_t start_x, int16_t start_y) {
+    SSD1306_STATS_TIME_BEGIN(begin);
+    const bool is_ok = ssd1306_print_text(ssd1306, text, text != NULL ? strlen(text) : 0, start_x, start_y);
+    SSD1306_STATS_TIME_END(ssd1306, print, begin);
+    return is_ok;
+}
+
+/**
+ * Place one laid-out line of a text box, recording it instead in streaming mode
+*/
+static bool ssd1306_print_span(ssd1306_t* ssd1306, const char* text, size_t length, uint8_t width, uint8_t x, uint8_t y) {
+    if (ssd1306->display_list != NULL) {
+        return ssd1306_display_list_record(ssd1306, SSD1306_DISPLAY_LIST_TEXT, ssd1306->font, x, y, width, (uint8_t)ssd1306_text_height(ssd1306), text, length);
+    }
+    return ssd1306_print_text(ssd1306, text, length, x, y);
+}
+
+#if SSD1306_TEXT_LAYOUT_CACHE_SLOTS > 0
+static uint16_t ssd1306_text_checksum(const char* text, uint16_t length) {
+    uint16_t checksum = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        checksum = (uint16_t)(((checksum << 1) | (checksum >> 15)) + (uint8_t)text[i]);
+    }
+    return checksum;
+}
+#endif
+
+/**
+ * Break text into lines no wider than box_width: at spaces where possible, inside a word
+ * that is wider than the box, and always at '\n'. Text left over after max_lines makes the
+ * last line end with an ellipsis when requested; that line is then cut at any character.
+*/
+static void ssd1306_layout_text(ssd1306_text_layout_t* layout, const ssd1306_t* ssd1306, const char* text, uint16_t length, uint8_t box_width, uint8_t max_lines, bool ellipsis) {
+    layout->line_count = 0;
+    layout->truncated = false;
+
+    uint16_t position = 0;
+    while (position < length && layout->line_count < max_lines) {
+        ssd1306_text_line_t* line = &layout->lines[layout->line_count++];
+        uint16_t end = position; // End of the drawn text, trailing spaces excluded
+        uint16_t width = 0; // Pixels of text[start, end)
+        uint16_t pen = 0; // Advance so far, spacing after the last glyph included
+        uint16_t next = length; // Start of the following line
+        bool has_break = false;
+        uint16_t break_end = 0;
+        uint16_t break_width = 0;
+        uint16_t break_next = 0;
+        line->start = position;
+
+        while (position < length) {
+            const char* cursor = text + position;
+            const uint32_t codepoint = ssd1306_utf8_next(&cursor);
+            const uint16_t after = (uint16_t)(cursor - text);
+            if (codepoint == '\n') {
+                next = after;
+                break;
+            }
+            if (codepoint == ' ') {
+                has_break = true;
+                break_end = end;
+                break_width = width;
+                break_next = after;
+                pen += ssd1306_word_spacing(ssd1306);
+                position = after;
+                continue;
+            }
+            const uint16_t glyph_width = ssd1306_glyph_width(ssd1306, codepoint);
+            if (pen + glyph_width > box_width && end > line->start) {
+                if (has_break) {
+                    end = break_end;
+                    width = break_width;
+                    next = break_next;
+                } else {
+                    next = position;
+                }
+                break;
+            }
+            width = pen + glyph_width;
+            pen = width + ssd1306_letter_spacing(ssd1306);
+            end = after;
+            position = after;
+        }
+
+        line->length = end - line->start;
+        line->width = (uint8_t)(width < UINT8_MAX ? width : UINT8_MAX);
+        position = next;
+    }
+
+    // Only visible characters left over count as truncated text.
+    while (position < length && (text[position] == ' ' || text[position] == '\n')) {
+        position++;
+    }
+    if (position >= length || !ellipsis || layout->line_count == 0) {
+        return;
+    }
+
+    const uint16_t ellipsis_width = 3 * ssd1306_glyph_width(ssd1306, '.') + 2 * ssd1306_letter_spacing(ssd1306);
+    ssd1306_text_line_t* line = &layout->lines[layout->line_count - 1];
+    uint16_t position_in_line = line->start;
+    uint16_t end = line->start;
+    uint16_t width = 0;
+    uint16_t pen = 0;
+    while (position_in_line < length) {
+        const char* cursor = text + position_in_line;
+        const uint32_t codepoint = ssd1306_utf8_next(&cursor);
+        if (codepoint == '\n') {
+            break;
+        }
+        if (codepoint == ' ') {
+            pen += ssd1306_word_spacing(ssd1306);
+        } else {
+            const uint16_t glyph_width = ssd1306_glyph_width(ssd1306, codepoint);
+            if (pen + glyph_width + ssd1306_letter_spacing(ssd1306) + ellipsis_width > box_width) {
+                break;
+            }
+            width = pen + glyph_width;
+            pen = width + ssd1306_letter_spacing(ssd1306);
+            end = (uint16_t)(cursor - text);
+        }
+        position_in_line = (uint16_t)(cursor - text);
+    }
+
+    const uint16_t total_width = (end > line->start ? width + ssd1306_letter_spacing(ssd1306) : 0) + ellipsis_width;
+    line->length = end - line->start;
+    line->width = (uint8_t)(total_width < UINT8_MAX ? total_width : UINT8_MAX);
+    layout->truncated = true;
+}
+
+/**
+ * Line breaks for a text box, from the cache when the same text was laid out the same way before
+*/
+static const ssd1306_text_layout_t* ssd1306_get_text_layout(ssd1306_t* ssd1306, ssd1306_text_layout_t* scratch, const char* text, uint16_t length, uint8_t box_width, uint8_t max_lines, bool ellipsis) {
+    const font_t* font = ssd1306->font;
+#if SSD1306_TEXT_LAYOUT_CACHE_SLOTS > 0
+    const uint16_t checksum = ssd1306_text_checksum(text, length);
+    for (uint8_t i = 0; i < SSD1306_TEXT_LAYOUT_CACHE_SLOTS; i++) {
+        const ssd1306_text_layout_t* cached = &ssd1306->text_layouts[i];
+        if (cached->text == text && cached->text_length == length && cached->checksum == checksum && cached->font == font &&
+            cached->text_scale == ssd1306->text_scale && cached->text_bold == ssd1306->text_bold && cached->box_width == box_width && cached->max_lines == max_lines && cached->ellipsis == ellipsis) {
+            return cached;
+        }
+    }
+    scratch = &ssd1306->text_layouts[ssd1306->text_layout_next];
+    ssd1306->text_layout_next = (ssd1306->text_layout_next + 1) % SSD1306_TEXT_LAYOUT_CACHE_SLOTS;
+    scratch->checksum = checksum;
+#endif
+    scratch->text = text;
+    scratch->text_length = length;
+    scratch->font = font;
+    scratch->text_scale = ssd1306->text_scale;
+    scratch->text_bold = ssd1306->text_bold;
+    scratch->box_width = box_width;
+    scratch->max_lines = max_lines;
+    scratch->ellipsis = ellipsis;
+    ssd1306_layout_text(scratch, ssd1306, text, length, box_width, max_lines, ellipsis);
+    return scratch;
+}
+
+/**
+ * Print text wrapped into a box. Lines break at spaces and '\n', and words wider than the box
+ * are split. Nothing is drawn outside the box.
+ * The line breaks are cached by text pointer and length, so redrawing a static text only blits glyphs.
+ * @param ssd1306
+ * @param text UTF-8, at most 65535 bytes
+ * @param x
+ * @param y
+ * @param width
+ * @param height
+ * @param style Alignment, line spacing and ellipsis. NULL = left aligned, no spacing, no ellipsis
+*/
+bool ssd1306_print_box(ssd1306_t* ssd1306, const char* text, uint8_t x, uint8_t y, uint8_t width, uint8_t height, const ssd1306_text_style_t* style) {
+    if (!ssd1306_is_ready(ssd1306) || ssd1306->font == NULL || text == NULL) {
+        return false;
+    }
+    const size_t length = strlen(text);
+    if (length > UINT16_MAX) {
+        return false;
+    }
+    const ssd1306_text_style_t default_style = { .align = SSD1306_ALIGN_LEFT, .line_spacing = 0, .ellipsis = false };
+    if (style == NULL) {
+        style = &default_style;
+    }
+    const uint16_t text_height = ssd1306_text_height(ssd1306);
+    const uint16_t line_height = text_height + style->line_spacing;
+    uint16_t max_lines = (height >= text_height) ? (height - text_height) / line_height + 1 : 0;
+    max_lines = max_lines < SSD1306_TEXT_BOX_LINES_MAX ? max_lines : SSD1306_TEXT_BOX_LINES_MAX;
+    if (max_lines == 0 || width == 0) {
+        return true;
+    }
+
+    SSD1306_STATS_TIME_BEGIN(begin);
+    ssd1306_text_layout_t scratch;
+    const ssd1306_text_layout_t* layout = ssd1306_get_text_layout(ssd1306, &scratch, text, (uint16_t)length, width, (uint8_t)max_lines, style->ellipsis);
+
+    // Clip to the box inside the current clip rectangle.
+    const uint8_t clip[] = { ssd1306->clip_x0, ssd1306->clip_y0, ssd1306->clip_x1, ssd1306->clip_y1 };
+    const uint16_t box_x1 = (uint16_t)x + width;
+    const uint16_t box_y1 = (uint16_t)y + height;
+    ssd1306->clip_x0 = x > clip[0] ? x : clip[0];
+    ssd1306->clip_y0 = y > clip[1] ? y : clip[1];
+    ssd1306->clip_x1 = box_x1 < clip[2] ? (uint8_t)box_x1 : clip[2];
+    ssd1306->clip_y1 = box_y1 < clip[3] ? (uint8_t)box_y1 : clip[3];
+
+    bool is_ok = true;
+    if (ssd1306->clip_x0 < ssd1306->clip_x1 && ssd1306->clip_y0 < ssd1306->clip_y1) {
+        for (uint8_t i = 0; i < layout->line_count; i++) {
+            const ssd1306_text_line_t* line = &layout->lines[i];
+            const uint8_t free_width = width > line->width ? width - line->width : 0;
+            const uint16_t line_x = x + (style->align == SSD1306_ALIGN_CENTER ? free_width / 2 : style->align == SSD1306_ALIGN_RIGHT ? free_width : 0);
+            const uint16_t line_y = y + i * line_height;
+            if (line_x >= ssd1306->width || line_y >= ssd1306->height) {
+                continue;
+            }
+            is_ok = ssd1306_print_span(ssd1306, text + line->start, line->length, line->width, (uint8_t)line_x, (uint8_t)line_y) && is_ok;
+            if (layout->truncated && i == layout->line_count - 1) {
+                const uint16_t ellipsis_width = 3 * ssd1306_glyph_width(ssd1306, '.') + 2 * ssd1306_letter_spacing(ssd1306);
+                const uint16_t ellipsis_x = line_x + line->width - ellipsis_width;
+                if (ellipsis_x < ssd1306->width) {
+                    is_ok = ssd1306_print_span(ssd1306, "...", 3, ellipsis_width, (uint8_t)ellipsis_x, (uint8_t)line_y) && is_ok;
+                }
+            }
+        }
+    }
+
+    ssd1306->clip_x0 = clip[0];
+    ssd1306->clip_y0 = clip[1];
+    ssd1306->clip_x1 = clip[2];
+    ssd1306->clip_y1 = clip[3];
+    SSD1306_STATS_TIME_END(ssd1306, print, begin);
+    return is_ok;
+}
+
+// Single commands addressing a page in page addressing mode, then the data control byte
+#define SSD1306_PAGE_PREFIX_LEN 7
+
+/**
+ * Transpose an 8x8 bit block: bit r of byte c becomes bit c of byte r.
+*/
+static inline uint64_t ssd1306_transpose_block(uint64_t block) {
+    uint64_t t = (block ^ (block << 28)) & 0x0F0F0F0F00000000ull;
+    block ^= t ^ (t >> 28);
+    t = (block ^ (block << 14)) & 0x3333000033330000ull;
+    block ^= t ^ (t >> 14);
+    t = (block ^ (block << 7)) & 0x5500550055005500ull;
+    block ^= t ^ (t >> 7);
+    return block;
+}
+
+/**
+ * Copy panel columns [start_column, start_column + columns) of a page to out. Rotated by 90 or 270
+ * degrees, panel page P is framebuffer columns 8P to 8P+7, so every 8 panel columns are one 8x8
+ * block of the framebuffer transposed, and start_column and columns are multiples of 8.
+*/
+static void ssd1306_read_panel_columns(const ssd1306_t* ssd1306, uint8_t page, uint8_t start_column, uint8_t columns, uint8_t* out) {
+    if (!ssd1306_is_portrait(ssd1306)) {
+        memcpy(out, ssd1306->buffer + 1 + ((uint16_t)(page - ssd1306->buffer_page) * ssd1306->width) + start_column, columns);
+        return;
+    }
+
+    const uint8_t* source = ssd1306->buffer + 1 + (uint16_t)(start_column / SSD1306_BITS_PER_COLUMN) * ssd1306->width + page * SSD1306_BITS_PER_COLUMN;
+    for (uint8_t column = 0; column < columns; column += SSD1306_BITS_PER_COLUMN) {
+        uint64_t block = 0;
+        for (uint8_t i = 0; i < SSD1306_BITS_PER_COLUMN; i++) {
+            block |= (uint64_t)source[i] << (i * SSD1306_BITS_IN_BYTE);
+        }
+        block = ssd1306_transpose_block(block);
+        for (uint8_t i = 0; i < SSD1306_BITS_PER_COLUMN; i++) {
+            out[column + i] = (uint8_t)(block >> (i * SSD1306_BITS_IN_BYTE));
+        }
+        source += ssd1306->width;
+    }
+}
+
+/**
+ * Send the dirty columns of one page in one transfer. tx starts with the precomputed prefix of
+ * single commands (page and column start address), only their values change from page to page.
+ * Each page carries its own address, so a flush can resume at any page.
+*/
+static bool ssd1306_write_page(ssd1306_t* ssd1306, uint8_t page, uint8_t* tx) {
+    const uint8_t start_column = ssd1306->dirty_start[page];
+    const uint8_t columns = ssd1306->dirty_end[page] - start_column;
+    const uint8_t ram_column = start_column + ssd1306->controller->column_offset;
+    tx[1] = (uint8_t)(SSD1306_PAGE_START_ADDRESS_COMMAND | page);
+    tx[3] = (uint8_t)(SSD1306_LOWER_COLUMN_START_ADDRESS_COMMAND | (ram_column & 0x0F));
+    tx[5] = (uint8_t)(SSD1306_HIGHER_COLUMN_START_ADDRESS_COMMAND | (ram_column >> 4));
+    ssd1306_read_panel_columns(ssd1306, page, start_column, columns, &tx[SSD1306_PAGE_PREFIX_LEN]);
+    return ssd1306_i2c_write(ssd1306, tx, (size_t)columns + SSD1306_PAGE_PREFIX_LEN);
+}
+
+/**
+ * Send framebuffer bytes straight from the buffer: the byte before them stands in
+ * for the data control byte during the transfer.
+ * @param offset Index of the first byte in the framebuffer (after buffer[0])
+*/
+static bool ssd1306_write_in_place(ssd1306_t* ssd1306, uint16_t offset, uint16_t length) {
+    uint8_t* transfer = ssd1306->buffer + offset;
+    const uint8_t saved = *transfer;
+    *transfer = SSD1306_SEND_DATA;
+    const bool is_ok = ssd1306_i2c_write(ssd1306, transfer, (size_t)length + 1);
+    *transfer = saved;
+    return is_ok;
+}
+
+/**
+ * Send panel columns of one page as a data transfer, for a framebuffer that is not in panel layout.
+*/
+static bool ssd1306_write_transposed(ssd1306_t* ssd1306, uint8_t page, uint8_t start_column, uint8_t columns) {
+    uint8_t data[1 + SSD1306_WIDTH_MAX];
+    data[0] = SSD1306_SEND_DATA;
+    ssd1306_read_panel_columns(ssd1306, page, start_column, columns, &data[1]);
+    return ssd1306_i2c_write(ssd1306, data, (size_t)columns + 1);
+}
+
+/**
+ * End of the run of dirty pages from first_page worth sending through one window. Widening the
+ * window resends clean columns in every page of the run, so the run stops at a page that is
+ * cheaper to address on its own.
+*/
+static uint8_t ssd1306_get_window_end(const ssd1306_t* ssd1306, uint8_t first_page, uint8_t pages) {
+    uint8_t start_column = ssd1306->dirty_start[first_page];
+    uint8_t end_column = ssd1306->dirty_end[first_page];
+    uint8_t end_page = first_page + 1;
+    while (end_page < pages && ssd1306->dirty_end[end_page] != 0) {
+        const uint8_t page_start = ssd1306->dirty_start[end_page];
+        const uint8_t page_end = ssd1306->dirty_end[end_page];
+        const uint8_t grown_start = page_start < start_column ? page_start : start_column;
+        const uint8_t grown_end = page_end > end_column ? page_end : end_column;
+        const uint16_t grown = (uint16_t)(grown_end - grown_start) * (end_page - first_page + 1);
+        const uint16_t separate = (uint16_t)(end_column - start_column) * (end_page - first_page) +
+                                  (page_end - page_start) + SSD1306_PAGE_PREFIX_LEN;
+        if (grown > separate) {
+            break;
+        }
+        start_column = grown_start;
+        end_column = grown_end;
+        end_page++;
+    }
+    return end_page;
+}
+
+/**
+ * Send the dirty pages [first_page, end_page) through one column/page address window covering
+ * all their dirty columns. The controller advances through the window by itself, so the data
+ * needs no further addressing: a window of full rows is one transfer, any other one transfer per page.
+ * Pages are marked clean as they are sent.
+*/
+static bool ssd1306_write_window(ssd1306_t* ssd1306, uint8_t first_page, uint8_t end_page) {
+    uint8_t start_column = ssd1306->dirty_start[first_page];
+    uint8_t end_column = ssd1306->dirty_end[first_page];
+    for (uint8_t page = first_page + 1; page < end_page; page++) {
+        start_column = ssd1306->dirty_start[page] < start_column ? ssd1306->dirty_start[page] : start_column;
+        end_column = ssd1306->dirty_end[page] > end_column ? ssd1306->dirty_end[page] : end_column;
+    }
+
+    const uint8_t column_offset = ssd1306->controller->column_offset;
+    const uint8_t window[] = {
+        SSD1306_SEND_COMMAND,
+        SSD1306_COLUMN_START_END_ADDRESS_COMMAND, (uint8_t)(start_column + column_offset), (uint8_t)(end_column - 1 + column_offset),
+        SSD1306_PAGE_START_END_ADDRESS_COMMAND, first_page, (uint8_t)(end_page - 1)
+    };
+    if (!ssd1306_i2c_write(ssd1306, window, sizeof(window))) {
+        return false;
+    }
+
+    const uint8_t columns = end_column - start_column;
+    if (ssd1306_is_portrait(ssd1306)) {
+        for (uint8_t page = first_page; page < end_page; page++) {
+            if (!ssd1306_write_transposed(ssd1306, page, start_column, columns)) {
+                return false;
+            }
+            ssd1306->dirty_end[page] = 0;
+        }
+        return true;
+    }
+    if (columns == ssd1306->width) {
+        if (!ssd1306_write_in_place(ssd1306, (uint16_t)first_page * ssd1306->width, (uint16_t)(end_page - first_page) * columns)) {
             return false;
         }
-        if (!ssd1306_send_command(ssd1306, 0x10)) {
+        memset(&ssd1306->dirty_end[first_page], 0, end_page - first_page);
+        return true;
+    }
+    for (uint8_t page = first_page; page < end_page; page++) {
+        if (!ssd1306_write_in_place(ssd1306, (uint16_t)page * ssd1306->width + start_column, columns)) {
             return false;
         }
+        ssd1306->dirty_end[page] = 0;
+    }
+    return true;
+}
+
+/**
+ * Streaming mode: replay the display list into the page buffer for one page.
+ * Each call is clipped to the page, and calls that cannot reach it are skipped.
+*/
+static void ssd1306_rasterize_page(ssd1306_t* ssd1306, uint8_t page) {
+    const uint8_t clip[] = { ssd1306->clip_x0, ssd1306->clip_y0, ssd1306->clip_x1, ssd1306->clip_y1 };
+    const font_t* font = ssd1306->font;
+    const uint8_t text_scale = ssd1306->text_scale;
+    const bool text_bold = ssd1306->text_bold;
+    const uint8_t page_y0 = page * SSD1306_BITS_PER_COLUMN;
+    const uint8_t page_y1 = page_y0 + SSD1306_BITS_PER_COLUMN;
+
+    memset(ssd1306->buffer + 1, 0, ssd1306->width);
+    ssd1306->buffer_page = page;
+
+    uint16_t offset = 0;
+    while (offset < ssd1306->display_list_size) {
+        const ssd1306_display_list_entry_t* entry = (const ssd1306_display_list_entry_t*)(ssd1306->display_list + offset);
+        offset += sizeof(ssd1306_display_list_entry_t) + entry->text_size;
+
+        const bitmap_t* bitmap = (const bitmap_t*)entry->source;
+        const font_t* entry_font = (const font_t*)entry->source;
+        const ssd1306_display_list_rect_t* rect = (const ssd1306_display_list_rect_t*)(entry + 1);
+        uint16_t height;
+        if (entry->op == SSD1306_DISPLAY_LIST_BITMAP) {
+            height = bitmap->height;
+        } else if (entry->op == SSD1306_DISPLAY_LIST_BITMAP_RECT) {
+            height = rect->height;
+        } else {
+            height = (uint16_t)entry_font->height * entry->text_scale;
+        }
+        ssd1306->clip_x0 = entry->clip_x0;
+        ssd1306->clip_x1 = entry->clip_x1;
+        ssd1306->clip_y0 = entry->clip_y0 > page_y0 ? entry->clip_y0 : page_y0;
+        ssd1306->clip_y1 = entry->clip_y1 < page_y1 ? entry->clip_y1 : page_y1;
+        if (ssd1306->clip_y0 >= ssd1306->clip_y1 || entry->y >= page_y1 || (uint16_t)entry->y + height <= page_y0) {
+            continue;
+        }
+
+        if (entry->op == SSD1306_DISPLAY_LIST_BITMAP) {
+            _ssd1306_draw_bitmap_internal(ssd1306, bitmap->data, 0, bitmap->format, bitmap->width, bitmap->height, entry->x, entry->y);
+        } else if (entry->op == SSD1306_DISPLAY_LIST_BITMAP_RECT) {
+            ssd1306_draw_bitmap_rect_internal(ssd1306, bitmap, rect->mask, rect->src_x, rect->src_y, rect->width, rect->height, entry->x, entry->y);
+        } else {
+            ssd1306->font = entry_font;
+            ssd1306->text_scale = entry->text_scale;
+            ssd1306->text_bold = entry->text_bold;
+            const char* text = (const char*)(entry + 1);
+            ssd1306_print_text(ssd1306, text, strlen(text), entry->x, entry->y);
+        }
+    }
+
+    ssd1306->clip_x0 = clip[0];
+    ssd1306->clip_y0 = clip[1];
+    ssd1306->clip_x1 = clip[2];
+    ssd1306->clip_y1 = clip[3];
+    ssd1306->font = font;
+    ssd1306->text_scale = text_scale;
+    ssd1306->text_bold = text_bold;
+}
+
+static bool ssd1306_show_frame(ssd1306_t* ssd1306) {
+    if (!ssd1306_is_ready(ssd1306)) {
+        return false;
+    }
+    // Nothing marked: the caller may have written ssd1306->buffer directly, so send the whole frame.
+    if (!ssd1306_is_dirty(ssd1306)) {
+        ssd1306_mark_all_dirty(ssd1306);
+    }
+
+    const uint8_t pages = ssd1306_get_panel_height(ssd1306) / SSD1306_BITS_PER_COLUMN;
+    uint8_t retries_left = SSD1306_FLUSH_RETRY_BUDGET;
+    uint32_t retry_delay_us = SSD1306_FLUSH_RETRY_DELAY_US;
+    bool frame_started = false;
+    uint8_t page = 0;
+
+    const ssd1306_flush_strategy_t strategy = ssd1306_get_flush_strategy(ssd1306);
+    uint8_t tx[SSD1306_PAGE_PREFIX_LEN + SSD1306_WIDTH_MAX] = {
+        SSD1306_SEND_COMMAND_SINGLE, 0, SSD1306_SEND_COMMAND_SINGLE, 0, SSD1306_SEND_COMMAND_SINGLE, 0, SSD1306_SEND_DATA
+    };
+
+    // Stages: queued commands + addressing mode, every dirty page, then commands that follow frame data.
+    while (page <= pages) {
+        bool is_ok;
+        if (ssd1306_is_nak_storm(ssd1306)) {
+            // Also after a storm in an earlier call: the controller must be configured before anything else is sent.
+            is_ok = ssd1306_recover_controller(ssd1306);
+            if (is_ok) {
+                frame_started = false;
+                page = 0;
+            }
+        } else if (!frame_started) {
+            is_ok = frame_started = ssd1306_send_queued_commands(ssd1306, SSD1306_QUEUE_BEFORE_FRAME, true);
+        } else if (page < pages && ssd1306->dirty_end[page] == 0) {
+            is_ok = true;
+            page++;
+        } else if (page < pages && strategy == SSD1306_FLUSH_WINDOW) {
+            const uint8_t end_page = ssd1306_get_window_end(ssd1306, page, pages);
+            is_ok = ssd1306_write_window(ssd1306, page, end_page);
+            page = is_ok ? end_page : page;
+        } else if (page < pages) {
+            if (ssd1306->display_list != NULL) {
+                ssd1306_rasterize_page(ssd1306, page);
+            }
+            is_ok = ssd1306_write_page(ssd1306, page, tx);
+            if (is_ok) {
+                ssd1306->dirty_end[page] = 0;
+                page++;
+            }
+        } else {
+            is_ok = ssd1306_send_queued_commands(ssd1306, SSD1306_QUEUE_AFTER_FRAME, false);
+            page += is_ok ? 1 : 0;
+        }
+        if (is_ok) {
+            continue;
+        }
 
-        memcpy(&tx[1], ssd1306->buffer + 1 + ((uint16_t)page * ssd1306->width), ssd1306->width);
-        if (!i2c_write_exact(i2c_write_timeout_us(ssd1306->i2c_inst, ssd1306->i2c_address, tx, (size_t)ssd1306->width + 1, false, SSD1306_I2C_TIMEOUT_US), (size_t)ssd1306->width + 1)) {
+        // Pages already sent stay clean, so a failed flush is resumed by the next ssd1306_show().
+        if (retries_left == 0) {
             return false;
         }
+        retries_left--;
+#if SSD1306_ENABLE_STATS
+        ssd1306->stats.flush_retries++;
+#endif
+        // Back off, so the retries span a brown-out of a few milliseconds instead of a few microseconds.
+        sleep_us(retry_delay_us);
+        retry_delay_us *= 2;
     }
 
     return true;
 }
 
+/**
+ * Send the changed columns of each page, or the whole frame if nothing was marked changed since the last flush
+*/
+bool ssd1306_show(ssd1306_t* ssd1306) {
+    SSD1306_STATS_TIME_BEGIN(begin);
+    const bool is_ok = ssd1306_show_frame(ssd1306);
+#if SSD1306_ENABLE_STATS
+    if (ssd1306 != NULL) {
+        const uint32_t elapsed_us = time_us_32() - begin;
+        ssd1306_stats_record_timing(&ssd1306->stats.show, elapsed_us);
+        if (is_ok) {
+            ssd1306_stats_record_flush(&ssd1306->stats, elapsed_us);
+        }
+    }
+#endif
+    return is_ok;
+}
+
+/**
+ * Flush only what is pending: the dirty areas, or just the queued commands of a clean frame.
+ * Unlike ssd1306_show(), a clean frame is not sent again.
+*/
+bool _ssd1306_show_pending(ssd1306_t* ssd1306) {
+    if (ssd1306_is_dirty(ssd1306)) {
+        return ssd1306_show(ssd1306);
+    }
+    return ssd1306 == NULL || ssd1306->command_queue_len == 0 || ssd1306_flush_commands(ssd1306);
+}
+
+// One I2C bus of an overlapped flush: the display being sent and its recorded transfers
+typedef struct {
+    ssd1306_t* display; // NULL while the bus is idle
+    uint8_t next; // Index of the next display to look at
+    ssd1306_transfer_log_t log;
+    uint16_t offset; // Next entry of the log
+    ssd1306_bus_transfer_t transfer;
+    // State of the display before recording, put back if a transfer fails so that the next flush sends it all again
+    uint8_t consecutive_naks;
+    uint8_t dirty_start[SSD1306_PAGES_MAX];
+    uint8_t dirty_end[SSD1306_PAGES_MAX];
+    uint8_t command_queue_len;
+    ssd1306_queued_command_t command_queue[SSD1306_COMMAND_QUEUE_CAPACITY];
+} ssd1306_overlap_bus_t;
+
+static uint8_t ssd1306_overlap_logs[NUM_I2CS][SSD1306_OVERLAP_LOG_SIZE];
+
+static void ssd1306_overlap_save(ssd1306_overlap_bus_t* bus, const ssd1306_t* ssd1306) {
+    bus->consecutive_naks = ssd1306->consecutive_naks;
+    memcpy(bus->dirty_start, ssd1306->dirty_start, sizeof(bus->dirty_start));
+    memcpy(bus->dirty_end, ssd1306->dirty_end, sizeof(bus->dirty_end));
+    bus->command_queue_len = ssd1306->command_queue_len;
+    memcpy(bus->command_queue, ssd1306->command_queue, sizeof(bus->command_queue));
+}
+
+static void ssd1306_overlap_restore(const ssd1306_overlap_bus_t* bus, ssd1306_t* ssd1306) {
+    ssd1306->consecutive_naks = bus->consecutive_naks;
+    memcpy(ssd1306->dirty_start, bus->dirty_start, sizeof(bus->dirty_start));
+    memcpy(ssd1306->dirty_end, bus->dirty_end, sizeof(bus->dirty_end));
+    ssd1306->command_queue_len = bus->command_queue_len;
+    memcpy(ssd1306->command_queue, bus->command_queue, sizeof(bus->command_queue));
+}
+
+static void ssd1306_overlap_start_transfer(ssd1306_overlap_bus_t* bus) {
+    const uint8_t* entry = bus->log.data + bus->offset;
+    const uint16_t len = (uint16_t)(entry[0] | entry[1] << 8);
+    bus->offset = (uint16_t)(bus->offset + 2 + len);
+    _ssd1306_bus_start(&bus->transfer, bus->display->i2c_inst, bus->display->i2c_address, entry + 2, len, ssd1306_get_transfer_timeout_us(bus->display, len));
+}
+
+/**
+ * Record the pending flush of the next display on the bus and start sending it.
+ * A display whose flush does not fit in the log is flushed on its own, blocking.
+ * @return false if a display failed
+*/
+static bool ssd1306_overlap_next_display(ssd1306_overlap_bus_t* bus, uint8_t bus_index, ssd1306_t* const* displays, uint8_t count) {
+    bool is_ok = true;
+    while (bus->next < count) {
+        ssd1306_t* ssd1306 = displays[bus->next++];
+        if (ssd1306 == NULL || i2c_get_index(ssd1306->i2c_inst) != bus_index) {
+            continue;
+        }
+        ssd1306_overlap_save(bus, ssd1306);
+        bus->log.size = 0;
+        bus->log.is_full = false;
+        ssd1306->transfer_log = &bus->log;
+        const bool is_recorded = _ssd1306_show_pending(ssd1306);
+        ssd1306->transfer_log = NULL;
+        if (!is_recorded) {
+            is_ok = false;
+            continue;
+        }
+        if (bus->log.is_full) {
+            ssd1306_overlap_restore(bus, ssd1306);
+            is_ok = _ssd1306_show_pending(ssd1306) && is_ok;
+            continue;
+        }
+        if (bus->log.size == 0) {
+            continue;
+        }
+        bus->display = ssd1306;
+        bus->offset = 0;
+        ssd1306_overlap_start_transfer(bus);
+        return is_ok;
+    }
+    return is_ok;
+}
+
+/**
+ * Flush the pending changes of several displays, overlapping the transfers of different I2C buses.
+ * Each display's flush is recorded first, then every bus is kept busy from this core by topping up
+ * its TX FIFO; displays on the same bus are sent one after another. A failed display gets back its
+ * dirty areas and queued commands, so the next flush sends it again.
+ * The transfer logs are static: call from one core at a time.
+ * @return false if any display failed
+*/
+bool _ssd1306_show_overlapped(ssd1306_t* const* displays, uint8_t count) {
+    ssd1306_overlap_bus_t buses[NUM_I2CS] = {};
+    bool is_ok = true;
+    for (uint8_t i = 0; i < NUM_I2CS; i++) {
+        buses[i].log.data = ssd1306_overlap_logs[i];
+        buses[i].log.capacity = SSD1306_OVERLAP_LOG_SIZE;
+        is_ok = ssd1306_overlap_next_display(&buses[i], i, displays, count) && is_ok;
+    }
+
+    bool is_busy = true;
+    while (is_busy) {
+        is_busy = false;
+        for (uint8_t i = 0; i < NUM_I2CS; i++) {
+            ssd1306_overlap_bus_t* bus = &buses[i];
+            if (bus->display == NULL) {
+                continue;
+            }
+            is_busy = true;
+            int result;
+            if (!_ssd1306_bus_poll(&bus->transfer, &result)) {
+                continue;
+            }
+            ssd1306_t* ssd1306 = bus->display;
+            const bool is_failed = result != (int)bus->transfer.len;
+            if (is_failed) {
+                ssd1306_overlap_restore(bus, ssd1306);
+            }
+            ssd1306_i2c_record_result(ssd1306, bus->transfer.data, bus->transfer.len, result);
+            if (!is_failed && bus->offset < bus->log.size) {
+                ssd1306_overlap_start_transfer(bus);
+                continue;
+            }
+            is_ok = is_ok && !is_failed;
+            bus->display = NULL;
+            is_ok = ssd1306_overlap_next_display(bus, i, displays, count) && is_ok;
+        }
+    }
+    return is_ok;
+}
+
 void ssd1306_destroy(ssd1306_t *ssd1306) {
     if (ssd1306 == NULL || ssd1306->buffer == NULL) {
         return;
     }
+    free(ssd1306->display_list);
+    ssd1306->display_list = NULL;
+    ssd1306->display_list_size = 0;
+    ssd1306->display_list_capacity = 0;
     free(ssd1306->buffer);
     ssd1306->buffer = NULL;
     ssd1306->buffer_size = 0;
@@ -9,22 +9,56 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "hardware/i2c.h"
 #include "ssd1306_def.h"
 
+extern const ssd1306_controller_t ssd1306_controller_ssd1306;
+extern const ssd1306_controller_t ssd1306_controller_sh1106;
+extern const ssd1306_controller_t ssd1306_controller_ssd1309;
+
 ssd1306_config_t ssd1306_get_default_config();
 ssd1306_t ssd1306_create(i2c_inst_t* i2c_inst, uint8_t i2c_address, ssd1306_display_size_t display_size);
+ssd1306_t ssd1306_create_streaming(i2c_inst_t* i2c_inst, uint8_t i2c_address, ssd1306_display_size_t display_size, uint16_t display_list_capacity);
+bool ssd1306_set_controller(ssd1306_t* ssd1306, const ssd1306_controller_t* controller);
+bool ssd1306_set_rotation(ssd1306_t* ssd1306, ssd1306_rotation_t rotation);
 bool ssd1306_init(ssd1306_t* ssd1306, const ssd1306_config_t* config);
+bool ssd1306_init_warm(ssd1306_t* ssd1306, const ssd1306_config_t* config);
+void ssd1306_set_i2c_baudrate(ssd1306_t* ssd1306, uint32_t baudrate);
+void ssd1306_set_command_batching(ssd1306_t* ssd1306, bool enabled);
+bool ssd1306_flush_commands(ssd1306_t* ssd1306);
 bool ssd1306_set_contrast(ssd1306_t* ssd1306, uint8_t contrast);
 bool ssd1306_set_inverse(ssd1306_t* ssd1306, bool value);
+bool ssd1306_set_start_line(ssd1306_t* ssd1306, uint8_t line);
+bool ssd1306_set_fade_out_blinking(ssd1306_t* ssd1306, ssd1306_fade_out_blinking_mode_t mode, uint8_t interval);
+bool ssd1306_set_zoom(ssd1306_t* ssd1306, bool enabled);
 bool ssd1306_display_on(ssd1306_t* ssd1306);
 bool ssd1306_display_off(ssd1306_t* ssd1306);
 bool ssd1306_clear_display(ssd1306_t* ssd1306);
 void ssd1306_set_font(ssd1306_t* ssd1306, const font_t* font);
+bool ssd1306_set_text_scale(ssd1306_t* ssd1306, uint8_t scale);
+void ssd1306_set_text_bold(ssd1306_t* ssd1306, bool bold);
 bool ssd1306_print(ssd1306_t* ssd1306, const char* text, uint8_t start_x, uint8_t start_y);
+bool ssd1306_print_box(ssd1306_t* ssd1306, const char* text, uint8_t x, uint8_t y, uint8_t width, uint8_t height, const ssd1306_text_style_t* style);
+uint32_t ssd1306_utf8_next(const char** text);
 bool ssd1306_draw_bitmap(ssd1306_t* ssd1306, const bitmap_t* bitmap, uint8_t start_x, uint8_t start_y);
+bool ssd1306_draw_bitmap_rect(ssd1306_t* ssd1306, const bitmap_t* bitmap, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y);
+bool ssd1306_draw_bitmap_masked(ssd1306_t* ssd1306, const bitmap_t* bitmap, const uint8_t* mask, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y);
+bool ssd1306_draw_atlas(ssd1306_t* ssd1306, const bitmap_atlas_t* atlas, uint16_t index, uint8_t start_x, uint8_t start_y);
+bool ssd1306_draw_gray(ssd1306_t* ssd1306, const uint8_t* pixels, uint16_t stride, uint8_t width, uint8_t height, uint8_t start_x, uint8_t start_y, ssd1306_dither_t dither);
+void ssd1306_set_clip(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+void ssd1306_reset_clip(ssd1306_t* ssd1306);
+void ssd1306_mark_dirty(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+bool ssd1306_save_region(const ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t* data, size_t size);
+bool ssd1306_restore_region(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint8_t* data);
+bool ssd1306_is_dirty(const ssd1306_t* ssd1306);
 bool ssd1306_show(ssd1306_t* ssd1306);
 void ssd1306_destroy(ssd1306_t* ssd1306);
 
+#if SSD1306_ENABLE_STATS
+const ssd1306_stats_t* ssd1306_get_stats(const ssd1306_t* ssd1306);
+void ssd1306_reset_stats(ssd1306_t* ssd1306);
+#endif
+
 
 #endif // SSD1306_H
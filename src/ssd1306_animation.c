@@ -0,0 +1,187 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "pico/time.h"
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_animation.h"
+
+#define SSD1306_ANIMATION_FRAME_HEADER 4 // duration_ms, runs_count
+#define SSD1306_ANIMATION_RUN_HEADER 3 // page, x, length
+
+/**
+ * Create a player for an animation
+ * @param ssd1306
+ * @param animation
+ * @param x, y Top left corner of the animation on the display, y a multiple of 8
+ * @param loop Play again from the first frame after the last one (needs an animation compiled with --loop)
+*/
+ssd1306_animation_player_t ssd1306_animation_player_create(ssd1306_t* ssd1306, const ssd1306_animation_t* animation, uint8_t x, uint8_t y, bool loop) {
+    ssd1306_animation_player_t player = {};
+    player.ssd1306 = ssd1306;
+    player.animation = animation;
+    player.x = x;
+    player.y = y;
+    player.loop = loop;
+    return player;
+}
+
+static uint16_t ssd1306_animation_read_u16(const uint8_t* data) {
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+/**
+ * Walk the frame at offset and, if draw is set, copy its runs into the framebuffer and mark them dirty.
+ * @return offset of the following frame, 0 if the frame is malformed
+*/
+static uint32_t ssd1306_animation_apply_frame(ssd1306_animation_player_t* player, uint32_t offset, bool draw, uint16_t* duration_ms) {
+    const ssd1306_animation_t* animation = player->animation;
+    ssd1306_t* ssd1306 = player->ssd1306;
+    const uint8_t pages = (animation->height + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN;
+    const uint8_t first_page = player->y / SSD1306_BITS_PER_COLUMN;
+
+    if (offset + SSD1306_ANIMATION_FRAME_HEADER > animation->size) {
+        return 0;
+    }
+    *duration_ms = ssd1306_animation_read_u16(animation->data + offset);
+    const uint16_t runs_count = ssd1306_animation_read_u16(animation->data + offset + 2);
+    offset += SSD1306_ANIMATION_FRAME_HEADER;
+
+    for (uint16_t i = 0; i < runs_count; i++) {
+        if (offset + SSD1306_ANIMATION_RUN_HEADER > animation->size) {
+            return 0;
+        }
+        const uint8_t* run = animation->data + offset;
+        const uint8_t page = run[0];
+        const uint8_t x = run[1];
+        const uint8_t length = run[2];
+        offset += SSD1306_ANIMATION_RUN_HEADER + length;
+        if (page >= pages || length == 0 || (uint16_t)x + length > animation->width || offset > animation->size) {
+            return 0;
+        }
+        if (draw) {
+            const uint8_t column = player->x + x;
+            memcpy(ssd1306->buffer + 1 + (uint16_t)(first_page + page) * ssd1306->width + column, run + SSD1306_ANIMATION_RUN_HEADER, length);
+            _ssd1306_mark_dirty_area(ssd1306, column, (first_page + page) * SSD1306_BITS_PER_COLUMN, length, SSD1306_BITS_PER_COLUMN);
+        }
+    }
+    return offset;
+}
+
+/**
+ * Clear the animation area and show the first frame at the next tick
+ * @return false if the area does not fit the display, y is not a multiple of 8,
+ *         there is no full framebuffer (streaming mode), or loop is set for an animation without a loop frame
+*/
+bool ssd1306_animation_player_start(ssd1306_animation_player_t* player) {
+    if (player == NULL || player->ssd1306 == NULL || player->ssd1306->buffer == NULL || player->ssd1306->display_list != NULL ||
+        player->animation == NULL || player->animation->data == NULL || player->animation->frames_count == 0) {
+        return false;
+    }
+    ssd1306_t* ssd1306 = player->ssd1306;
+    const ssd1306_animation_t* animation = player->animation;
+    const uint8_t pages = (animation->height + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN;
+    if (player->y % SSD1306_BITS_PER_COLUMN != 0 || (uint16_t)player->x + animation->width > ssd1306->width ||
+        (uint16_t)player->y + pages * SSD1306_BITS_PER_COLUMN > ssd1306->height || (player->loop && animation->loop_offset == 0)) {
+        return false;
+    }
+
+    uint8_t* destination = ssd1306->buffer + 1 + (uint16_t)(player->y / SSD1306_BITS_PER_COLUMN) * ssd1306->width + player->x;
+    for (uint8_t page = 0; page < pages; page++) {
+        memset(destination, 0, animation->width);
+        destination += ssd1306->width;
+    }
+    _ssd1306_mark_dirty_area(ssd1306, player->x, player->y, animation->width, (uint16_t)pages * SSD1306_BITS_PER_COLUMN);
+
+    player->frame = 0;
+    player->offset = 0;
+    player->next_frame_us = time_us_64();
+    player->playing = true;
+    return true;
+}
+
+/**
+ * Stop at the current frame, it stays on the display
+*/
+void ssd1306_animation_player_stop(ssd1306_animation_player_t* player) {
+    if (player != NULL) {
+        player->playing = false;
+    }
+}
+
+/**
+ * Move to the frame after the one just applied. Past the last frame comes the loop frame, which
+ * restores the first frame, so playback continues with the second one.
+ * @return false if the data is malformed
+*/
+static bool ssd1306_animation_player_advance(ssd1306_animation_player_t* player, uint32_t next_offset) {
+    const ssd1306_animation_t* animation = player->animation;
+    if (player->frame == animation->frames_count) {
+        uint16_t duration_ms;
+        player->frame = 1;
+        player->offset = ssd1306_animation_apply_frame(player, 0, false, &duration_ms);
+        if (player->offset == 0) {
+            return false;
+        }
+    } else {
+        player->frame++;
+        player->offset = next_offset;
+    }
+
+    if (player->frame == animation->frames_count) {
+        if (!player->loop) {
+            player->playing = false;
+        }
+        player->offset = animation->loop_offset;
+    }
+    return true;
+}
+
+/**
+ * Call from the main loop as often as possible. Applies the runs of every frame that is due and
+ * flushes once, so the bus only carries the columns that changed. Frames whose time passed while
+ * the bus was busy are merged into one flush; frames with a duration of 0 are shown one per call,
+ * as fast as the bus allows.
+ * @return false if the animation data is malformed (playback stops) or the flush failed
+*/
+bool ssd1306_animation_player_tick(ssd1306_animation_player_t* player) {
+    if (player == NULL || player->ssd1306 == NULL || player->animation == NULL) {
+        return false;
+    }
+    if (!player->playing) {
+        return true;
+    }
+
+    const uint64_t now = time_us_64();
+    bool is_applied = false;
+    uint16_t frames = 0;
+    while (player->playing && now >= player->next_frame_us) {
+        uint16_t duration_ms;
+        const uint32_t next_offset = ssd1306_animation_apply_frame(player, player->offset, true, &duration_ms);
+        if (next_offset == 0 || !ssd1306_animation_player_advance(player, next_offset)) {
+            player->playing = false;
+            return false;
+        }
+        is_applied = true;
+        player->next_frame_us += (uint64_t)duration_ms * 1000;
+        if (duration_ms == 0) {
+            break;
+        }
+        // A whole cycle behind: restart the schedule instead of catching up.
+        if (++frames >= player->animation->frames_count) {
+            player->next_frame_us = now;
+            break;
+        }
+    }
+
+    return is_applied ? ssd1306_show(player->ssd1306) : true;
+}
+
+bool ssd1306_animation_player_is_playing(const ssd1306_animation_player_t* player) {
+    return player != NULL && player->playing;
+}
@@ -0,0 +1,49 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_ANIMATION_H
+#define SSD1306_ANIMATION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_def.h"
+
+/**
+ * Delta-encoded animation, produced by tools/assets/ssd1306_assets.py from a .anim manifest.
+ * Each frame stores only the page/column runs that differ from the previous frame:
+ *   uint16_t duration_ms (little endian, 0 = next frame as soon as the bus allows)
+ *   uint16_t runs_count (little endian)
+ *   runs_count times: uint8_t page, uint8_t x, uint8_t length, length page-layout bytes
+ * The first frame is encoded against a blank area.
+*/
+typedef struct {
+    uint8_t width;
+    uint8_t height; // Rounded up to whole pages when drawn
+    uint16_t frames_count;
+    uint32_t size; // Bytes of data
+    uint32_t loop_offset; // Offset of the frame that turns the last frame back into the first, 0 = does not loop
+    const uint8_t* data;
+} ssd1306_animation_t;
+
+typedef struct {
+    ssd1306_t* ssd1306;
+    const ssd1306_animation_t* animation;
+    uint8_t x;
+    uint8_t y; // Multiple of 8
+    bool loop;
+    bool playing;
+    uint16_t frame; // Index of the next frame
+    uint32_t offset; // Offset of the next frame in animation->data
+    uint64_t next_frame_us; // When the next frame is due
+} ssd1306_animation_player_t;
+
+ssd1306_animation_player_t ssd1306_animation_player_create(ssd1306_t* ssd1306, const ssd1306_animation_t* animation, uint8_t x, uint8_t y, bool loop);
+bool ssd1306_animation_player_start(ssd1306_animation_player_t* player);
+void ssd1306_animation_player_stop(ssd1306_animation_player_t* player);
+bool ssd1306_animation_player_tick(ssd1306_animation_player_t* player);
+bool ssd1306_animation_player_is_playing(const ssd1306_animation_player_t* player);
+
+#endif // SSD1306_ANIMATION_H
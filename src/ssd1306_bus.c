@@ -0,0 +1,64 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+// Non-blocking I2C writes for flushing displays on several buses at once: the caller polls each
+// transfer in turn and every poll tops up that controller's TX FIFO.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/time.h"
+#include "hardware/i2c.h"
+#include "ssd1306_internal.h"
+
+/**
+ * Address the device and clear the status of the previous transfer. Bytes are queued by _ssd1306_bus_poll().
+*/
+void _ssd1306_bus_start(ssd1306_bus_transfer_t* transfer, i2c_inst_t* i2c_inst, uint8_t address, const uint8_t* data, size_t len, uint32_t timeout_us) {
+    *transfer = (ssd1306_bus_transfer_t){
+        .i2c_inst = i2c_inst,
+        .data = data,
+        .len = len,
+        .deadline_us = time_us_64() + timeout_us,
+    };
+    i2c_hw_t* hw = i2c_get_hw(i2c_inst);
+    hw->enable = 0;
+    hw->tar = address;
+    hw->enable = 1;
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+}
+
+/**
+ * Queue as many bytes as the TX FIFO takes and check whether the transfer has finished.
+ * The last byte carries STOP; the transfer is over once the controller reports the STOP condition.
+ * @param result Set when finished: len, PICO_ERROR_GENERIC if NAKed or PICO_ERROR_TIMEOUT
+ * @return true if finished
+*/
+bool _ssd1306_bus_poll(ssd1306_bus_transfer_t* transfer, int* result) {
+    i2c_hw_t* hw = i2c_get_hw(transfer->i2c_inst);
+    // Read once: a STOP seen here was sent after every byte queued by earlier polls.
+    const uint32_t status = hw->raw_intr_stat;
+    if ((status & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) != 0) {
+        (void)hw->clr_tx_abrt;
+        transfer->is_aborted = true;
+    }
+    if ((status & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS) != 0 && (transfer->is_aborted || transfer->queued == transfer->len)) {
+        (void)hw->clr_stop_det;
+        *result = transfer->is_aborted ? PICO_ERROR_GENERIC : (int)transfer->len;
+        return true;
+    }
+    while (!transfer->is_aborted && transfer->queued < transfer->len && i2c_get_write_available(transfer->i2c_inst) > 0) {
+        const bool is_last = transfer->queued + 1 == transfer->len;
+        hw->data_cmd = (is_last ? I2C_IC_DATA_CMD_STOP_BITS : 0) | transfer->data[transfer->queued];
+        transfer->queued++;
+    }
+    if (time_us_64() > transfer->deadline_us) {
+        *result = PICO_ERROR_TIMEOUT;
+        return true;
+    }
+    return false;
+}
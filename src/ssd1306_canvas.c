@@ -0,0 +1,267 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_canvas.h"
+
+/**
+ * Create a canvas that spans a grid of displays. Panels must be the same size, initialized and
+ * have a full framebuffer (not page-streaming); they may be on different I2C buses.
+ * Canvas coordinates run across the seams: on two 128x64 panels side by side, x = 128 is the
+ * first column of the right panel.
+ * @param panels columns * rows displays, row by row from the top left
+ * @param columns, rows Grid size
+*/
+ssd1306_canvas_t ssd1306_canvas_create(ssd1306_t* const* panels, uint8_t columns, uint8_t rows) {
+    ssd1306_canvas_t canvas = {};
+    const uint16_t count = (uint16_t)columns * rows;
+    if (panels == NULL || count == 0 || count > SSD1306_CANVAS_PANELS_MAX || panels[0] == NULL) {
+        return canvas;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        const ssd1306_t* panel = panels[i];
+        if (panel == NULL || panel->buffer == NULL || panel->display_list != NULL ||
+            panel->width != panels[0]->width || panel->height != panels[0]->height) {
+            return canvas;
+        }
+        canvas.panels[i] = panels[i];
+    }
+    canvas.columns = columns;
+    canvas.rows = rows;
+    canvas.panel_width = panels[0]->width;
+    canvas.panel_height = panels[0]->height;
+    canvas.width = (uint16_t)columns * canvas.panel_width;
+    canvas.height = (uint16_t)rows * canvas.panel_height;
+    return canvas;
+}
+
+static bool ssd1306_canvas_is_valid(const ssd1306_canvas_t* canvas) {
+    return canvas != NULL && canvas->width > 0;
+}
+
+static uint8_t ssd1306_canvas_count(const ssd1306_canvas_t* canvas) {
+    return canvas->columns * canvas->rows;
+}
+
+static uint16_t ssd1306_canvas_panel_x(const ssd1306_canvas_t* canvas, uint8_t panel) {
+    return (uint16_t)(panel % canvas->columns) * canvas->panel_width;
+}
+
+static uint16_t ssd1306_canvas_panel_y(const ssd1306_canvas_t* canvas, uint8_t panel) {
+    return (uint16_t)(panel / canvas->columns) * canvas->panel_height;
+}
+
+/**
+ * Clear the framebuffers of all panels
+*/
+bool ssd1306_canvas_clear(ssd1306_canvas_t* canvas) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return false;
+    }
+    bool is_ok = true;
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        is_ok = ssd1306_clear_display(canvas->panels[i]) && is_ok;
+    }
+    return is_ok;
+}
+
+void ssd1306_canvas_set_font(ssd1306_canvas_t* canvas, const font_t* font) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return;
+    }
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        ssd1306_set_font(canvas->panels[i], font);
+    }
+}
+
+bool ssd1306_canvas_set_text_scale(ssd1306_canvas_t* canvas, uint8_t scale) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return false;
+    }
+    bool is_ok = true;
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        is_ok = ssd1306_set_text_scale(canvas->panels[i], scale) && is_ok;
+    }
+    return is_ok;
+}
+
+void ssd1306_canvas_set_text_bold(ssd1306_canvas_t* canvas, bool bold) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return;
+    }
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        ssd1306_set_text_bold(canvas->panels[i], bold);
+    }
+}
+
+/**
+ * Limit drawing to [x, x + width) x [y, y + height) of the canvas. Each panel is clipped to
+ * its part of the rectangle; panels outside it draw nothing.
+*/
+void ssd1306_canvas_set_clip(ssd1306_canvas_t* canvas, uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return;
+    }
+    const uint32_t x1 = (uint32_t)x + width;
+    const uint32_t y1 = (uint32_t)y + height;
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        const uint16_t panel_x = ssd1306_canvas_panel_x(canvas, i);
+        const uint16_t panel_y = ssd1306_canvas_panel_y(canvas, i);
+        const uint16_t clip_x0 = x > panel_x ? x : panel_x;
+        const uint16_t clip_y0 = y > panel_y ? y : panel_y;
+        const uint32_t clip_x1 = x1 < (uint32_t)panel_x + canvas->panel_width ? x1 : (uint32_t)panel_x + canvas->panel_width;
+        const uint32_t clip_y1 = y1 < (uint32_t)panel_y + canvas->panel_height ? y1 : (uint32_t)panel_y + canvas->panel_height;
+        if (clip_x0 < clip_x1 && clip_y0 < clip_y1) {
+            ssd1306_set_clip(canvas->panels[i], clip_x0 - panel_x, clip_y0 - panel_y, clip_x1 - clip_x0, clip_y1 - clip_y0);
+        } else {
+            ssd1306_set_clip(canvas->panels[i], 0, 0, 0, 0);
+        }
+    }
+}
+
+/**
+ * Allow drawing on the whole canvas again
+*/
+void ssd1306_canvas_reset_clip(ssd1306_canvas_t* canvas) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return;
+    }
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        ssd1306_reset_clip(canvas->panels[i]);
+    }
+}
+
+/**
+ * Print text with the canvas font. Every panel the line reaches prints it from its own origin,
+ * so a glyph that crosses a seam is cut by the panel edges and appears on both sides.
+*/
+bool ssd1306_canvas_print(ssd1306_canvas_t* canvas, const char* text, uint16_t x, uint16_t y) {
+    if (!ssd1306_canvas_is_valid(canvas) || text == NULL) {
+        return false;
+    }
+    bool is_ok = true;
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        ssd1306_t* panel = canvas->panels[i];
+        if (panel->font == NULL) {
+            return false;
+        }
+        const uint16_t panel_x = ssd1306_canvas_panel_x(canvas, i);
+        const uint16_t panel_y = ssd1306_canvas_panel_y(canvas, i);
+        const uint16_t text_height = (uint16_t)panel->font->height * panel->text_scale;
+        if (x >= panel_x + canvas->panel_width || y >= panel_y + canvas->panel_height || (uint32_t)y + text_height <= panel_y) {
+            continue;
+        }
+        is_ok = _ssd1306_print_at(panel, text, (int16_t)(x - panel_x), (int16_t)(y - panel_y)) && is_ok;
+    }
+    return is_ok;
+}
+
+/**
+ * Draw the part of a bitmap rectangle that falls on one panel
+*/
+static bool ssd1306_canvas_draw_part(ssd1306_canvas_t* canvas, uint8_t panel, const bitmap_t* bitmap, const uint8_t* mask, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint16_t x, uint16_t y) {
+    const uint16_t panel_x = ssd1306_canvas_panel_x(canvas, panel);
+    const uint16_t panel_y = ssd1306_canvas_panel_y(canvas, panel);
+    const uint16_t x0 = x > panel_x ? x : panel_x;
+    const uint16_t y0 = y > panel_y ? y : panel_y;
+    const uint32_t x1 = (uint32_t)x + width < (uint32_t)panel_x + canvas->panel_width ? (uint32_t)x + width : (uint32_t)panel_x + canvas->panel_width;
+    const uint32_t y1 = (uint32_t)y + height < (uint32_t)panel_y + canvas->panel_height ? (uint32_t)y + height : (uint32_t)panel_y + canvas->panel_height;
+    if (x0 >= x1 || y0 >= y1) {
+        return true;
+    }
+    return ssd1306_draw_bitmap_masked(canvas->panels[panel], bitmap, mask, src_x + (x0 - x), src_y + (y0 - y),
+                                      (uint8_t)(x1 - x0), (uint8_t)(y1 - y0), (uint8_t)(x0 - panel_x), (uint8_t)(y0 - panel_y));
+}
+
+/**
+ * Draw a bitmap anywhere on the canvas. It is split at the seams into source rectangles, one per panel it covers.
+*/
+bool ssd1306_canvas_draw_bitmap(ssd1306_canvas_t* canvas, const bitmap_t* bitmap, uint16_t x, uint16_t y) {
+    if (bitmap == NULL) {
+        return false;
+    }
+    return ssd1306_canvas_draw_bitmap_masked(canvas, bitmap, NULL, 0, 0, bitmap->width, bitmap->height, x, y);
+}
+
+/**
+ * Draw a sub-rectangle of a bitmap through an optional mask, see ssd1306_draw_bitmap_masked()
+*/
+bool ssd1306_canvas_draw_bitmap_masked(ssd1306_canvas_t* canvas, const bitmap_t* bitmap, const uint8_t* mask, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint16_t x, uint16_t y) {
+    if (!ssd1306_canvas_is_valid(canvas) || bitmap == NULL || bitmap->data == NULL || width == 0 || height == 0 ||
+        (uint16_t)src_x + width > bitmap->width || (uint16_t)src_y + height > bitmap->height) {
+        return false;
+    }
+    bool is_ok = true;
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        is_ok = ssd1306_canvas_draw_part(canvas, i, bitmap, mask, src_x, src_y, width, height, x, y) && is_ok;
+    }
+    return is_ok;
+}
+
+/**
+ * Draw one icon of an atlas, see ssd1306_draw_atlas()
+*/
+bool ssd1306_canvas_draw_atlas(ssd1306_canvas_t* canvas, const bitmap_atlas_t* atlas, uint16_t index, uint16_t x, uint16_t y) {
+    if (!ssd1306_canvas_is_valid(canvas) || atlas == NULL || atlas->rects == NULL || index >= atlas->rects_count) {
+        return false;
+    }
+    bool is_ok = true;
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        // Panels may have their own residency arenas, look the atlas up in each.
+        const struct ssd1306_resident_arena* arena = canvas->panels[i]->resident_arena;
+        const bitmap_atlas_t* panel_atlas = arena != NULL ? _ssd1306_resident_find(arena, atlas) : atlas;
+        const bitmap_rect_t* rect = &panel_atlas->rects[index];
+        is_ok = ssd1306_canvas_draw_part(canvas, i, &panel_atlas->sheet, panel_atlas->mask, rect->x, rect->y, rect->width, rect->height, x, y) && is_ok;
+    }
+    return is_ok;
+}
+
+/**
+ * Any panel has changes that were not shown yet
+*/
+bool ssd1306_canvas_is_dirty(const ssd1306_canvas_t* canvas) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        if (ssd1306_is_dirty(canvas->panels[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Flush every panel. Each one sends only its own dirty areas, and a panel without changes sends
+ * nothing, so drawing on one half of a two-panel canvas leaves the other panel's bus idle.
+ * Panels on different I2C buses are sent at the same time from this core; a failed panel does not
+ * stop the others and is sent again by the next call.
+*/
+bool ssd1306_canvas_show(ssd1306_canvas_t* canvas) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return false;
+    }
+    return _ssd1306_show_overlapped(canvas->panels, ssd1306_canvas_count(canvas));
+}
+
+/**
+ * Flush only the panels on one I2C bus, with blocking transfers. Lets each core own one bus:
+ * the calls touch disjoint panels. Do not draw on a panel while its bus is being flushed.
+*/
+bool ssd1306_canvas_show_bus(ssd1306_canvas_t* canvas, const i2c_inst_t* i2c_inst) {
+    if (!ssd1306_canvas_is_valid(canvas)) {
+        return false;
+    }
+    bool is_ok = true;
+    for (uint8_t i = 0; i < ssd1306_canvas_count(canvas); i++) {
+        if (canvas->panels[i]->i2c_inst == i2c_inst) {
+            is_ok = _ssd1306_show_pending(canvas->panels[i]) && is_ok;
+        }
+    }
+    return is_ok;
+}
@@ -0,0 +1,46 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_CANVAS_H
+#define SSD1306_CANVAS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hardware/i2c.h"
+#include "ssd1306_def.h"
+
+#ifndef SSD1306_CANVAS_PANELS_MAX
+// Displays one canvas can span, e.g. a 2x2 grid
+#define SSD1306_CANVAS_PANELS_MAX 4
+#endif
+
+// Several displays of the same size drawn as one, in a grid of columns x rows
+typedef struct {
+    ssd1306_t* panels[SSD1306_CANVAS_PANELS_MAX]; // Row by row, top left first
+    uint8_t columns;
+    uint8_t rows;
+    uint8_t panel_width;
+    uint8_t panel_height;
+    uint16_t width; // 0 if the panels do not form a valid grid
+    uint16_t height;
+} ssd1306_canvas_t;
+
+ssd1306_canvas_t ssd1306_canvas_create(ssd1306_t* const* panels, uint8_t columns, uint8_t rows);
+bool ssd1306_canvas_clear(ssd1306_canvas_t* canvas);
+void ssd1306_canvas_set_font(ssd1306_canvas_t* canvas, const font_t* font);
+bool ssd1306_canvas_set_text_scale(ssd1306_canvas_t* canvas, uint8_t scale);
+void ssd1306_canvas_set_text_bold(ssd1306_canvas_t* canvas, bool bold);
+void ssd1306_canvas_set_clip(ssd1306_canvas_t* canvas, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+void ssd1306_canvas_reset_clip(ssd1306_canvas_t* canvas);
+bool ssd1306_canvas_print(ssd1306_canvas_t* canvas, const char* text, uint16_t x, uint16_t y);
+bool ssd1306_canvas_draw_bitmap(ssd1306_canvas_t* canvas, const bitmap_t* bitmap, uint16_t x, uint16_t y);
+bool ssd1306_canvas_draw_bitmap_masked(ssd1306_canvas_t* canvas, const bitmap_t* bitmap, const uint8_t* mask, uint8_t src_x, uint8_t src_y, uint8_t width, uint8_t height, uint16_t x, uint16_t y);
+bool ssd1306_canvas_draw_atlas(ssd1306_canvas_t* canvas, const bitmap_atlas_t* atlas, uint16_t index, uint16_t x, uint16_t y);
+bool ssd1306_canvas_is_dirty(const ssd1306_canvas_t* canvas);
+bool ssd1306_canvas_show(ssd1306_canvas_t* canvas);
+bool ssd1306_canvas_show_bus(ssd1306_canvas_t* canvas, const i2c_inst_t* i2c_inst);
+
+#endif // SSD1306_CANVAS_H
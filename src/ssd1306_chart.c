@@ -0,0 +1,206 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "pico/time.h"
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_chart.h"
+
+/**
+ * Create a strip chart. Set chart.style and chart.hardware_scroll afterwards to change the defaults.
+ * @param ssd1306
+ * @param x, y Top left corner, y a multiple of 8
+ * @param width Columns, also the number of samples shown
+ * @param height Rows, a multiple of 8 up to SSD1306_CHART_HEIGHT_MAX
+ * @param min, max Sample values on the bottom and top row, samples outside are clamped
+*/
+ssd1306_chart_t ssd1306_chart_create(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t min, int16_t max) {
+    ssd1306_chart_t chart = {};
+    chart.ssd1306 = ssd1306;
+    chart.x = x;
+    chart.y = y;
+    chart.width = width;
+    chart.height = height;
+    chart.min = min;
+    chart.max = max;
+    chart.style = SSD1306_CHART_LINE;
+    return chart;
+}
+
+/**
+ * The chart fits the display and there is a full framebuffer (not available in page-streaming mode)
+*/
+static bool ssd1306_chart_is_valid(const ssd1306_chart_t* chart) {
+    if (chart == NULL || chart->ssd1306 == NULL) {
+        return false;
+    }
+    const ssd1306_t* ssd1306 = chart->ssd1306;
+    return ssd1306->buffer != NULL && ssd1306->display_list == NULL && chart->min < chart->max &&
+           chart->width > 0 && chart->width <= SSD1306_WIDTH_MAX && chart->height > 0 && chart->height <= SSD1306_CHART_HEIGHT_MAX &&
+           chart->y % SSD1306_BITS_PER_COLUMN == 0 && chart->height % SSD1306_BITS_PER_COLUMN == 0 &&
+           (uint16_t)chart->x + chart->width <= ssd1306->width && (uint16_t)chart->y + chart->height <= ssd1306->height;
+}
+
+/**
+ * Row of a sample in the chart, 0 = top
+*/
+static uint8_t ssd1306_chart_get_row(const ssd1306_chart_t* chart, int16_t sample) {
+    if (sample >= chart->max) {
+        return 0;
+    }
+    if (sample <= chart->min) {
+        return chart->height - 1;
+    }
+    const int32_t range = (int32_t)chart->max - chart->min;
+    return (uint8_t)((((int32_t)chart->max - sample) * (chart->height - 1) + range / 2) / range);
+}
+
+/**
+ * Replace one column of the chart in the framebuffer
+ * @param has_previous Whether the sample to the left is known, a line starts there
+*/
+static void ssd1306_chart_draw_column(ssd1306_chart_t* chart, uint8_t column, int16_t sample, int16_t previous, bool has_previous) {
+    ssd1306_t* ssd1306 = chart->ssd1306;
+    const uint8_t row = ssd1306_chart_get_row(chart, sample);
+    uint8_t top = row;
+    uint8_t bottom = row;
+    if (chart->style == SSD1306_CHART_BARS) {
+        bottom = chart->height - 1;
+    } else if (has_previous) {
+        const uint8_t previous_row = ssd1306_chart_get_row(chart, previous);
+        top = previous_row < row ? previous_row : row;
+        bottom = previous_row > row ? previous_row : row;
+    }
+    const uint64_t bits = (~0ull >> (63 - (bottom - top))) << top;
+
+    uint8_t* destination = ssd1306->buffer + 1 + (uint16_t)(chart->y / SSD1306_BITS_PER_COLUMN) * ssd1306->width + chart->x + column;
+    for (uint8_t page = 0; page < chart->height / SSD1306_BITS_PER_COLUMN; page++) {
+        *destination = (uint8_t)(bits >> (page * SSD1306_BITS_IN_BYTE));
+        destination += ssd1306->width;
+    }
+}
+
+/**
+ * Scroll the chart columns of the controller RAM one column to the left, as the framebuffer is
+ * about to be. Columns not flushed yet move along, so their dirty range grows by one column to the left.
+ * @return false if the RAM was not scrolled: not requested, not supported, too soon after the previous
+ *         scroll, or the transfer failed
+*/
+static bool ssd1306_chart_scroll_controller(ssd1306_chart_t* chart) {
+    ssd1306_t* ssd1306 = chart->ssd1306;
+    if (!chart->hardware_scroll || !ssd1306->is_configured || chart->width < 2 ||
+        (ssd1306->controller->features & SSD1306_CONTROLLER_CONTENT_SCROLL) == 0 ||
+        (ssd1306->rotation != SSD1306_ROTATION_0 && ssd1306->rotation != SSD1306_ROTATION_180)) {
+        return false;
+    }
+    const uint64_t now = time_us_64();
+    if (now < chart->next_scroll_us) {
+        return false;
+    }
+
+    const uint8_t first_page = chart->y / SSD1306_BITS_PER_COLUMN;
+    const uint8_t last_page = (chart->y + chart->height) / SSD1306_BITS_PER_COLUMN - 1;
+    const uint8_t column_offset = ssd1306->controller->column_offset;
+    const uint8_t commands[] = {
+        SSD1306_SEND_COMMAND,
+        SSD1306_CONTENT_SCROLL_LEFT_COMMAND, 0x00, first_page, 0x01, last_page,
+        (uint8_t)(chart->x + column_offset), (uint8_t)(chart->x + chart->width - 1 + column_offset)
+    };
+    if (!_ssd1306_send_commands(ssd1306, commands, sizeof(commands))) {
+        return false;
+    }
+    chart->next_scroll_us = now + SSD1306_CONTENT_SCROLL_INTERVAL_US;
+
+    const uint8_t end_column = chart->x + chart->width;
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        const uint8_t start = ssd1306->dirty_start[page];
+        if (ssd1306->dirty_end[page] != 0 && start > chart->x && start < end_column) {
+            ssd1306->dirty_start[page] = start - 1;
+        }
+    }
+    return true;
+}
+
+/**
+ * Forget all samples and blank the chart area
+*/
+bool ssd1306_chart_clear(ssd1306_chart_t* chart) {
+    if (!ssd1306_chart_is_valid(chart)) {
+        return false;
+    }
+    ssd1306_t* ssd1306 = chart->ssd1306;
+    chart->samples_count = 0;
+    chart->samples_next = 0;
+
+    uint8_t* destination = ssd1306->buffer + 1 + (uint16_t)(chart->y / SSD1306_BITS_PER_COLUMN) * ssd1306->width + chart->x;
+    for (uint8_t page = 0; page < chart->height / SSD1306_BITS_PER_COLUMN; page++) {
+        memset(destination, 0, chart->width);
+        destination += ssd1306->width;
+    }
+    _ssd1306_mark_dirty_area(ssd1306, chart->x, chart->y, chart->width, chart->height);
+    return true;
+}
+
+/**
+ * Add a sample on the right, shifting the older ones one column to the left.
+ * The framebuffer band is moved page by page with memmove() and only the new column is drawn.
+ * The whole band is marked dirty, unless hardware_scroll is set and the controller scrolled its
+ * RAM by one column as well (SSD1306_CONTROLLER_CONTENT_SCROLL, landscape only, at most one
+ * scroll per SSD1306_CONTENT_SCROLL_INTERVAL_US): then only the new column is sent.
+ * Several samples pushed between two ssd1306_show() calls cost one flush of the band.
+*/
+bool ssd1306_chart_push(ssd1306_chart_t* chart, int16_t sample) {
+    if (!ssd1306_chart_is_valid(chart)) {
+        return false;
+    }
+    ssd1306_t* ssd1306 = chart->ssd1306;
+    const bool has_previous = chart->samples_count > 0;
+    const int16_t previous = chart->samples[(chart->samples_next + chart->width - 1) % chart->width];
+    chart->samples[chart->samples_next] = sample;
+    chart->samples_next = (chart->samples_next + 1) % chart->width;
+    if (chart->samples_count < chart->width) {
+        chart->samples_count++;
+    }
+
+    const bool is_scrolled = ssd1306_chart_scroll_controller(chart);
+    uint8_t* row = ssd1306->buffer + 1 + (uint16_t)(chart->y / SSD1306_BITS_PER_COLUMN) * ssd1306->width + chart->x;
+    for (uint8_t page = 0; page < chart->height / SSD1306_BITS_PER_COLUMN; page++) {
+        memmove(row, row + 1, chart->width - 1);
+        row += ssd1306->width;
+    }
+    ssd1306_chart_draw_column(chart, chart->width - 1, sample, previous, has_previous);
+
+    if (is_scrolled) {
+        _ssd1306_mark_dirty_area(ssd1306, chart->x + chart->width - 1, chart->y, 1, chart->height);
+    } else {
+        _ssd1306_mark_dirty_area(ssd1306, chart->x, chart->y, chart->width, chart->height);
+    }
+    return true;
+}
+
+/**
+ * Draw the chart again from its samples, e.g. after clearing the display or changing min, max or style
+*/
+bool ssd1306_chart_redraw(ssd1306_chart_t* chart) {
+    const uint8_t samples_count = chart != NULL ? chart->samples_count : 0;
+    const uint8_t samples_next = chart != NULL ? chart->samples_next : 0;
+    if (!ssd1306_chart_clear(chart)) {
+        return false;
+    }
+    chart->samples_count = samples_count;
+    chart->samples_next = samples_next;
+
+    const uint8_t oldest = (uint8_t)((samples_next + chart->width - samples_count) % chart->width);
+    const uint8_t first_column = chart->width - samples_count;
+    for (uint8_t i = 0; i < samples_count; i++) {
+        const int16_t sample = chart->samples[(oldest + i) % chart->width];
+        const int16_t previous = chart->samples[(oldest + i + chart->width - 1) % chart->width];
+        ssd1306_chart_draw_column(chart, first_column + i, sample, previous, i > 0);
+    }
+    return true;
+}
@@ -0,0 +1,53 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_CHART_H
+#define SSD1306_CHART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_def.h"
+
+#ifndef SSD1306_CHART_HEIGHT_MAX
+// Tallest chart band in pixels
+#define SSD1306_CHART_HEIGHT_MAX 64
+#endif
+
+#ifndef SSD1306_CONTENT_SCROLL_INTERVAL_US
+// Time the controller needs between two one-column content scrolls (two frame periods with the default config).
+// Samples pushed sooner are shifted in the framebuffer only.
+#define SSD1306_CONTENT_SCROLL_INTERVAL_US 15000
+#endif
+
+typedef enum {
+    SSD1306_CHART_LINE = 0x00, // Each column connects the previous sample to this one
+    SSD1306_CHART_BARS = 0x01, // Each column is filled from the sample down to the bottom of the chart
+} ssd1306_chart_style_t;
+
+typedef struct {
+    ssd1306_t* ssd1306;
+    uint8_t x;
+    uint8_t y; // Multiple of 8
+    uint8_t width; // One sample per column, the newest on the right
+    uint8_t height; // Multiple of 8
+    int16_t min; // Sample value on the bottom row
+    int16_t max; // Sample value on the top row
+    ssd1306_chart_style_t style; // SSD1306_CHART_LINE unless set after ssd1306_chart_create()
+    bool hardware_scroll; // Scroll the controller RAM as well, so a new sample sends one column per page
+
+    // Ring buffer of the samples shown, oldest first
+    int16_t samples[SSD1306_WIDTH_MAX];
+    uint8_t samples_count;
+    uint8_t samples_next; // Index the next sample is stored at
+    uint64_t next_scroll_us; // Earliest time of the next content scroll
+} ssd1306_chart_t;
+
+ssd1306_chart_t ssd1306_chart_create(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint8_t width, uint8_t height, int16_t min, int16_t max);
+bool ssd1306_chart_clear(ssd1306_chart_t* chart);
+bool ssd1306_chart_push(ssd1306_chart_t* chart, int16_t sample);
+bool ssd1306_chart_redraw(ssd1306_chart_t* chart);
+
+#endif // SSD1306_CHART_H
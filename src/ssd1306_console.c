@@ -0,0 +1,279 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_console.h"
+
+/**
+ * Create a console that fills the display with a grid of font cells. Each cell is the font width
+ * plus letter spacing wide; variable width glyphs are drawn at the left of their cell.
+ * Text rows are a power of two pages high, so a 10 pixel font takes two pages per row.
+ * Landscape 64 pixel high displays scroll with the display start line (hardware_scroll).
+ * The console owns the whole display, call ssd1306_console_clear() before the first write.
+ * @param ssd1306
+ * @param font
+*/
+ssd1306_console_t ssd1306_console_create(ssd1306_t* ssd1306, const font_t* font) {
+    ssd1306_console_t console = {};
+    console.ssd1306 = ssd1306;
+    console.font = font;
+    if (ssd1306 == NULL || font == NULL || font->width == 0 || font->height == 0) {
+        return console;
+    }
+
+    const uint8_t font_pages = (font->height + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN;
+    uint8_t row_pages = 1;
+    while (row_pages < font_pages) {
+        row_pages *= 2;
+    }
+    const uint8_t pages = ssd1306->height / SSD1306_BITS_PER_COLUMN;
+    if (row_pages > pages) {
+        return console;
+    }
+    console.cell_width = font->width + font->letter_spacing;
+    console.row_pages = row_pages;
+    console.columns = ssd1306->width / console.cell_width;
+    console.rows = pages / row_pages;
+    if (console.columns > SSD1306_CONSOLE_COLUMNS_MAX) {
+        console.columns = SSD1306_CONSOLE_COLUMNS_MAX;
+    }
+    if (console.rows > SSD1306_CONSOLE_ROWS_MAX) {
+        console.rows = SSD1306_CONSOLE_ROWS_MAX;
+    }
+    // The start line wraps around the 64 rows of the RAM, so the rows must fill all of it.
+    console.hardware_scroll = (ssd1306->rotation == SSD1306_ROTATION_0 || ssd1306->rotation == SSD1306_ROTATION_180) &&
+                              pages == SSD1306_PAGES_MAX && (uint16_t)console.rows * row_pages == SSD1306_PAGES_MAX;
+    return console;
+}
+
+/**
+ * The grid fits the display and there is a full framebuffer (not available in page-streaming mode)
+*/
+static bool ssd1306_console_is_valid(const ssd1306_console_t* console) {
+    if (console == NULL || console->ssd1306 == NULL || console->font == NULL || console->columns == 0) {
+        return false;
+    }
+    const ssd1306_t* ssd1306 = console->ssd1306;
+    return ssd1306->buffer != NULL && ssd1306->display_list == NULL &&
+           (uint16_t)console->columns * console->cell_width <= ssd1306->width &&
+           (uint16_t)console->rows * console->row_pages * SSD1306_BITS_PER_COLUMN <= ssd1306->height;
+}
+
+static uint8_t ssd1306_console_get_slot(const ssd1306_console_t* console, uint8_t row) {
+    return (uint8_t)((console->top_slot + row) % console->rows);
+}
+
+/**
+ * Encode a codepoint as NUL-terminated UTF-8 for ssd1306_print()
+*/
+static void ssd1306_console_encode_utf8(uint16_t codepoint, char* text) {
+    if (codepoint < 0x80) {
+        text[0] = (char)codepoint;
+        text[1] = '\0';
+    } else if (codepoint < 0x800) {
+        text[0] = (char)(0xC0 | (codepoint >> 6));
+        text[1] = (char)(0x80 | (codepoint & 0x3F));
+        text[2] = '\0';
+    } else {
+        text[0] = (char)(0xE0 | (codepoint >> 12));
+        text[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        text[2] = (char)(0x80 | (codepoint & 0x3F));
+        text[3] = '\0';
+    }
+}
+
+/**
+ * Draw a codepoint into a cell of a row slot. A cell that already shows it is left alone,
+ * otherwise only the cell is cleared, drawn and marked dirty, so the flush carries changed cells only.
+*/
+static void ssd1306_console_set_cell(ssd1306_console_t* console, uint8_t slot, uint8_t column, uint16_t codepoint) {
+    if (console->cells[slot][column] == codepoint) {
+        return;
+    }
+    console->cells[slot][column] = codepoint;
+
+    ssd1306_t* ssd1306 = console->ssd1306;
+    const uint8_t x = column * console->cell_width;
+    const uint8_t y = slot * console->row_pages * SSD1306_BITS_PER_COLUMN;
+    uint8_t* destination = ssd1306->buffer + 1 + (uint16_t)(slot * console->row_pages) * ssd1306->width + x;
+    for (uint8_t page = 0; page < console->row_pages; page++) {
+        memset(destination, 0, console->cell_width);
+        destination += ssd1306->width;
+    }
+    _ssd1306_mark_dirty_area(ssd1306, x, y, console->cell_width, (uint16_t)console->row_pages * SSD1306_BITS_PER_COLUMN);
+    if (codepoint == ' ') {
+        return;
+    }
+
+    // Draw with the console font at scale 1 over the whole display, whatever the caller set.
+    const font_t* font = ssd1306->font;
+    const uint8_t text_scale = ssd1306->text_scale;
+    const bool text_bold = ssd1306->text_bold;
+    const uint8_t clip[] = { ssd1306->clip_x0, ssd1306->clip_y0, ssd1306->clip_x1, ssd1306->clip_y1 };
+    ssd1306->font = console->font;
+    ssd1306->text_scale = 1;
+    ssd1306->text_bold = false;
+    ssd1306_reset_clip(ssd1306);
+
+    char text[4];
+    ssd1306_console_encode_utf8(codepoint, text);
+    ssd1306_print(ssd1306, text, x, y);
+
+    ssd1306->font = font;
+    ssd1306->text_scale = text_scale;
+    ssd1306->text_bold = text_bold;
+    ssd1306->clip_x0 = clip[0];
+    ssd1306->clip_y0 = clip[1];
+    ssd1306->clip_x1 = clip[2];
+    ssd1306->clip_y1 = clip[3];
+}
+
+/**
+ * Blank the cells of the cursor row that still show the previous line
+*/
+static void ssd1306_console_clear_stale(ssd1306_console_t* console) {
+    const uint8_t slot = ssd1306_console_get_slot(console, console->cursor_row);
+    for (uint8_t column = console->stale_column; column < console->columns; column++) {
+        ssd1306_console_set_cell(console, slot, column, ' ');
+    }
+    console->stale_column = console->columns;
+}
+
+/**
+ * Move every line one row up and recycle the top row as the new bottom row.
+ * With hardware_scroll only the display start line changes, the rows stay where they are in RAM.
+ * The start line is sent by the next flush after the frame data, so the recycled row is rewritten
+ * before it comes into view at the bottom.
+ * Otherwise each row is redrawn from the one below, cell by cell, so only cells that differ are sent.
+*/
+static bool ssd1306_console_scroll(ssd1306_console_t* console) {
+    if (console->hardware_scroll) {
+        console->top_slot = (console->top_slot + 1) % console->rows;
+        return _ssd1306_set_start_line_after_frame(console->ssd1306, console->top_slot * console->row_pages * SSD1306_BITS_PER_COLUMN);
+    }
+    for (uint8_t row = 0; row + 1 < console->rows; row++) {
+        for (uint8_t column = 0; column < console->columns; column++) {
+            ssd1306_console_set_cell(console, row, column, console->cells[row + 1][column]);
+        }
+    }
+    return true;
+}
+
+/**
+ * End the cursor row and start a new line below it, scrolling at the bottom. The new line is
+ * written over the cells the row shows, the cells it does not reach are blanked afterwards.
+*/
+static bool ssd1306_console_new_line(ssd1306_console_t* console) {
+    ssd1306_console_clear_stale(console);
+    console->new_line_pending = false;
+    console->cursor_column = 0;
+    console->stale_column = 0;
+    if (console->cursor_row + 1 < console->rows) {
+        console->cursor_row++;
+        return true;
+    }
+    return ssd1306_console_scroll(console);
+}
+
+/**
+ * Blank the display, put the cursor in the top left cell and move the start line back to row 0.
+ * The start line moves with the blank frame on the next ssd1306_show().
+*/
+bool ssd1306_console_clear(ssd1306_console_t* console) {
+    if (!ssd1306_console_is_valid(console)) {
+        return false;
+    }
+    ssd1306_t* ssd1306 = console->ssd1306;
+    for (uint8_t slot = 0; slot < console->rows; slot++) {
+        for (uint8_t column = 0; column < console->columns; column++) {
+            console->cells[slot][column] = ' ';
+        }
+    }
+    memset(ssd1306->buffer + 1, 0, ssd1306->buffer_size - 1);
+    _ssd1306_mark_dirty_area(ssd1306, 0, 0, ssd1306->width, ssd1306->height);
+
+    console->cursor_column = 0;
+    console->cursor_row = 0;
+    console->top_slot = 0;
+    console->stale_column = console->columns;
+    console->new_line_pending = false;
+    if (console->hardware_scroll || ssd1306->config.start_line != SSD1306_DISPLAY_START_LINE_MIN) {
+        return _ssd1306_set_start_line_after_frame(ssd1306, SSD1306_DISPLAY_START_LINE_MIN);
+    }
+    return true;
+}
+
+/**
+ * Write UTF-8 text at the cursor. '\n' starts a new line, scrolling at the bottom, '\r' returns to
+ * the first column, '\t' advances to the next multiple of SSD1306_CONSOLE_TAB_WIDTH, other control
+ * characters are ignored. Lines longer than the console wrap.
+ * A '\n' takes effect with the next character, so the last line stays on the bottom row instead of
+ * an empty one, and the next line is compared with the line its row showed before: only the cells
+ * that changed are marked dirty. Show them with ssd1306_show(), which also moves the start line.
+ * @return false if the console is invalid or the start line could not be queued
+*/
+bool ssd1306_console_write(ssd1306_console_t* console, const char* text) {
+    if (!ssd1306_console_is_valid(console) || text == NULL) {
+        return false;
+    }
+    bool is_ok = true;
+    uint32_t codepoint;
+    while ((codepoint = ssd1306_utf8_next(&text)) != 0) {
+        if (console->new_line_pending) {
+            is_ok = ssd1306_console_new_line(console) && is_ok;
+        }
+        if (codepoint == '\n') {
+            console->new_line_pending = true;
+            continue;
+        }
+        if (codepoint == '\r') {
+            console->cursor_column = 0;
+            continue;
+        }
+        uint8_t count = 1;
+        if (codepoint == '\t') {
+            codepoint = ' ';
+            count = SSD1306_CONSOLE_TAB_WIDTH - console->cursor_column % SSD1306_CONSOLE_TAB_WIDTH;
+        } else if (codepoint < ' ' || codepoint == 0x7F) {
+            continue;
+        } else if (codepoint > 0xFFFF) {
+            codepoint = SSD1306_UTF8_REPLACEMENT;
+        }
+
+        for (; count > 0; count--) {
+            if (console->cursor_column >= console->columns) {
+                is_ok = ssd1306_console_new_line(console) && is_ok;
+            }
+            const uint8_t slot = ssd1306_console_get_slot(console, console->cursor_row);
+            ssd1306_console_set_cell(console, slot, console->cursor_column, (uint16_t)codepoint);
+            console->cursor_column++;
+            if (console->stale_column < console->cursor_column) {
+                console->stale_column = console->cursor_column;
+            }
+        }
+    }
+    ssd1306_console_clear_stale(console);
+    return is_ok;
+}
+
+/**
+ * Move the cursor. Text written there replaces the cells it covers and leaves the rest of the row.
+ * @param column 0 to columns - 1
+ * @param row 0 to rows - 1, 0 = top
+*/
+bool ssd1306_console_set_cursor(ssd1306_console_t* console, uint8_t column, uint8_t row) {
+    if (!ssd1306_console_is_valid(console) || column >= console->columns || row >= console->rows) {
+        return false;
+    }
+    console->cursor_column = column;
+    console->cursor_row = row;
+    console->stale_column = console->columns;
+    console->new_line_pending = false;
+    return true;
+}
@@ -0,0 +1,51 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_CONSOLE_H
+#define SSD1306_CONSOLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_def.h"
+
+#ifndef SSD1306_CONSOLE_COLUMNS_MAX
+// Widest console in cells, a 3-pixel font with 1 pixel letter spacing on 128 columns
+#define SSD1306_CONSOLE_COLUMNS_MAX 32
+#endif
+
+#ifndef SSD1306_CONSOLE_ROWS_MAX
+// Tallest console in text rows, one page per row on a 128 pixel high portrait display
+#define SSD1306_CONSOLE_ROWS_MAX 16
+#endif
+
+#ifndef SSD1306_CONSOLE_TAB_WIDTH
+// '\t' moves the cursor to the next multiple of this column
+#define SSD1306_CONSOLE_TAB_WIDTH 4
+#endif
+
+typedef struct {
+    ssd1306_t* ssd1306;
+    const font_t* font;
+    uint8_t cell_width; // Font width plus letter spacing
+    uint8_t row_pages; // Pages per text row, a power of two so the rows tile the 64-row display RAM
+    uint8_t columns; // 0 if the font does not fit the display
+    uint8_t rows;
+    bool hardware_scroll; // Scrolls by moving the display start line, set by ssd1306_console_create() where possible
+
+    uint8_t cursor_column; // Equal to columns after the last cell of a row, the next character wraps
+    uint8_t cursor_row; // Text row on the screen, 0 = top
+    uint8_t top_slot; // Framebuffer row slot shown at the top of the screen
+    uint8_t stale_column; // Cells of the cursor row from here on still hold the line the row showed before
+    bool new_line_pending; // A '\n' was written last, the new line starts with the next character
+    uint16_t cells[SSD1306_CONSOLE_ROWS_MAX][SSD1306_CONSOLE_COLUMNS_MAX]; // Codepoint drawn in each cell, by row slot
+} ssd1306_console_t;
+
+ssd1306_console_t ssd1306_console_create(ssd1306_t* ssd1306, const font_t* font);
+bool ssd1306_console_clear(ssd1306_console_t* console);
+bool ssd1306_console_write(ssd1306_console_t* console, const char* text);
+bool ssd1306_console_set_cursor(ssd1306_console_t* console, uint8_t column, uint8_t row);
+
+#endif // SSD1306_CONSOLE_H
@@ -13,17 +13,100 @@
 #include "bitmap.h"
 #include "font.h"
 
+struct ssd1306_resident_arena;
+struct ssd1306_transfer_log;
+
 #ifndef SSD1306_I2C_TIMEOUT_US
 // Timeout for a full I2C transfer. Must be enough for framebuffer writes
 // (e.g. 1025 bytes for 128x64), otherwise writes can be truncated.
 #define SSD1306_I2C_TIMEOUT_US 100000
 #endif
 
+#ifndef SSD1306_I2C_TIMEOUT_SLACK_US
+// Fixed allowance added to the per-transfer deadline computed from the I2C baud rate (clock stretching, IRQ latency).
+#define SSD1306_I2C_TIMEOUT_SLACK_US 1000
+#endif
+
+#ifndef SSD1306_FLUSH_RETRY_BUDGET
+// Failed transfers ssd1306_show() may retry before giving up. The flush resumes from the failed page.
+#define SSD1306_FLUSH_RETRY_BUDGET 4
+#endif
+
+#ifndef SSD1306_FLUSH_RETRY_DELAY_US
+// Wait before the first retry of a failed transfer, doubled for each further retry (1 + 2 + 4 + 8 ms with the default budget).
+#define SSD1306_FLUSH_RETRY_DELAY_US 1000
+#endif
+
+#ifndef SSD1306_OVERLAP_LOG_SIZE
+// Bytes of transfers recorded per I2C bus when displays on several buses are flushed at once (ssd1306_canvas_show()).
+// A display whose flush does not fit is flushed on its own. 1536 holds a full 128x64 frame with its commands.
+#define SSD1306_OVERLAP_LOG_SIZE 1536
+#endif
+
+#ifndef SSD1306_NAK_STORM_THRESHOLD
+// Consecutive NAKed transfers after which the controller is assumed to have reset and is initialized again.
+#define SSD1306_NAK_STORM_THRESHOLD 3
+#endif
+
+#ifndef SSD1306_ENABLE_STATS
+// Set to 1 to collect per-display performance counters in ssd1306_t.stats.
+// Must be defined the same way for the library and the application (use a PUBLIC compile definition).
+#define SSD1306_ENABLE_STATS 0
+#endif
+
+#ifndef SSD1306_COMMAND_QUEUE_CAPACITY
+// Runtime setter commands held until the next flush (after collapsing redundant ones).
+#define SSD1306_COMMAND_QUEUE_CAPACITY 8
+#endif
+
+#ifndef SSD1306_WARM_INIT_SCRATCH
+// First watchdog scratch register holding the hash of settings persisted for ssd1306_init_warm().
+// Only displays initialized with ssd1306_init_warm() use it, other applications keep it free.
+// Scratch registers 0-3 are free for applications, 4-7 are used by the bootrom.
+#define SSD1306_WARM_INIT_SCRATCH 0
+#endif
+
+#ifndef SSD1306_WARM_INIT_SLOTS
+// Displays initialized with ssd1306_init_warm() whose settings survive a soft reset; each uses one scratch register.
+// A display that finds every slot taken by another display is not persisted and starts cold.
+#define SSD1306_WARM_INIT_SLOTS 1
+#endif
+
+#ifndef SSD1306_WARM_INIT_SPINLOCK
+// Hardware spin lock guarding the persisted settings, which displays on both cores may update.
+#define SSD1306_WARM_INIT_SPINLOCK PICO_SPINLOCK_ID_STRIPED_FIRST
+#endif
+
+#ifndef SSD1306_TEXT_LAYOUT_CACHE_SLOTS
+// Line breaks of this many ssd1306_print_box() texts are kept between calls, 0 = lay out on every call.
+#define SSD1306_TEXT_LAYOUT_CACHE_SLOTS 4
+#endif
+
+#ifndef SSD1306_TEXT_BOX_LINES_MAX
+// Lines drawn by one ssd1306_print_box() call at most
+#define SSD1306_TEXT_BOX_LINES_MAX 8
+#endif
+
+#ifndef SSD1306_UTF8_REPLACEMENT
+// Codepoint printed in place of malformed UTF-8 (overlong, surrogate, truncated or out of range).
+#define SSD1306_UTF8_REPLACEMENT '?'
+#endif
+
 #define SSD1306_BITS_PER_COLUMN 8 // quantity segments in one column
 #define SSD1306_BITS_IN_BYTE 8 // 1 byte = 8 bits
+#define SSD1306_PAGES_MAX 8 // 64 rows / 8 rows per page
+#define SSD1306_BUFFER_PAGES_MAX 16 // Framebuffer pages: 128 rows when rotated to portrait
+#define SSD1306_WIDTH_MAX 128 // columns of the controller RAM
+#define SSD1306_TEXT_SCALE_MAX 4 // ssd1306_set_text_scale() factors 1-4
+#define SSD1306_STYLED_GLYPH_HEIGHT_MAX 32 // Font height up to which glyphs can be scaled or made bold
+// Bytes ssd1306_save_region() needs for a width x height area at any y (it may span one more page)
+#define SSD1306_REGION_SIZE(width, height) ((width) * (((height) + 2 * SSD1306_BITS_PER_COLUMN - 2) / SSD1306_BITS_PER_COLUMN))
 
 #define SSD1306_SEND_COMMAND 0x00
 #define SSD1306_SEND_DATA 0x40
+#define SSD1306_SEND_COMMAND_SINGLE 0x80 // Co = 1: one command byte follows, then another control byte
+
+#define SSD1306_STATUS_DISPLAY_OFF 0x40 // Status byte (I2C read) bit 6: display is OFF
 
 // 1. Fundamental Command
 #define SSD1306_CONTRAST_COMMAND 0x81 // Value: 1-255
@@ -39,12 +122,17 @@
 #define SSD1306_DISPLAY_ON_COMMAND 0xAF // Display ON in normal mode
 
 // 2. Scrolling Command
-// ...
+#define SSD1306_CONTENT_SCROLL_RIGHT_COMMAND 0x2C // Move the RAM columns of a page/column window right by one column
+#define SSD1306_CONTENT_SCROLL_LEFT_COMMAND 0x2D // Move the RAM columns of a page/column window left by one column
 
 // 3. Addressing Setting Command
 // - Set Lower Column Start Address for Page Addressing Mode. This command is only for page addressing mode. 0x00~0x0F (0-15)
 // - Set Higher Column Start Address for Page Addressing Mode. This command is only for page addressing mode. 0x10~0x1F (16-31)
 // - Set Page Start Address for Page Addressing Mode. This command is only for page addressing mode. 0xB0~0xB7 (176-183)
+#define SSD1306_LOWER_COLUMN_START_ADDRESS_COMMAND 0x00 // OR with column & 0x0F
+#define SSD1306_HIGHER_COLUMN_START_ADDRESS_COMMAND 0x10 // OR with column >> 4
+#define SSD1306_PAGE_START_ADDRESS_COMMAND 0xB0 // OR with page (0-7)
+
 #define SSD1306_MEMORY_ADDRESSING_MODE_COMMAND 0x20
 typedef enum {
     SSD1306_MEMORY_ADDRESSING_MODE_HORIZONTAL = 0x00, // Horizontal Addressing Mode
@@ -63,6 +151,8 @@ typedef enum {
 // 4. Hardware Configuration (Panel resolution & layout related) Command
 // - Set Display Start Line. 0x40~0x7F (64-127)
 #define SSD1306_DISPLAY_START_LINE_COMMAND 0x40 // Set Display First Line (0-63)
+#define SSD1306_DISPLAY_START_LINE_MIN 0x00 // 0 (RESET)
+#define SSD1306_DISPLAY_START_LINE_MAX 0x3F // 63
 
 #define SSD1306_SEGMENT_RE_MAP_NORMAL_COMMAND 0xA0 // Set Segment Re-map. Column address 0 is mapped to SEG0 (RESET)
 #define SSD1306_SEGMENT_RE_MAP_INVERSE_COMMAND 0xA1 // Set Segment Re-map. Column address 127 is mapped to SEG0
@@ -125,6 +215,36 @@ typedef enum {
 #define SSD1306_CHARGE_PUMP_ENABLE 0x14 // Enable charge pump during display on
 #define SSD1306_CHARGE_PUMP_DISABLE 0x10 // Disable charge pump (RESET)
 
+// Commands of compatible controllers
+#define SH1106_DC_DC_CONTROL_COMMAND 0xAD // Set DC-DC converter ON/OFF
+#define SH1106_DC_DC_ON 0x8B // Built-in DC-DC on while the display is on
+#define SSD1309_COMMAND_LOCK_COMMAND 0xFD // Set Command Lock
+#define SSD1309_COMMAND_UNLOCK 0x12 // Accept all commands (RESET)
+
+#define SSD1306_CONTROLLER_INIT_COMMANDS_MAX 8
+// Features of ssd1306_controller_t
+#define SSD1306_CONTROLLER_CHARGE_PUMP 0x01 // Charge pump command (0x8D), sent from config.charge_pump
+#define SSD1306_CONTROLLER_FADE_ZOOM 0x02 // Fade out / blinking (0x23) and zoom in (0xD6) commands
+#define SSD1306_CONTROLLER_CONTENT_SCROLL 0x04 // One-column content scroll (0x2C/0x2D)
+#define SSD1306_ADDRESSING_MODE_BIT(mode) (1u << (mode))
+
+typedef enum {
+    SSD1306_FLUSH_PAGES = 0x00, // One transfer per dirty page: command prefix addressing the page, then its columns
+    SSD1306_FLUSH_WINDOW = 0x01, // Column/page window over each run of dirty pages, then the data as one burst
+} ssd1306_flush_strategy_t;
+
+// What differs between SSD1306-compatible controllers
+typedef struct {
+    const char* name;
+    const uint8_t* init_commands; // Sent first at init, before display OFF and the settings built from ssd1306_config_t
+    uint8_t init_commands_len; // Up to SSD1306_CONTROLLER_INIT_COMMANDS_MAX
+    uint8_t ram_width; // Columns of display RAM
+    uint8_t column_offset; // RAM column shown at panel column 0
+    uint8_t addressing_modes; // SSD1306_ADDRESSING_MODE_BIT() of each supported mode; page mode only = no 0x20 command
+    uint8_t features; // SSD1306_CONTROLLER_* bits
+    ssd1306_flush_strategy_t flush; // Fastest flush the controller supports
+} ssd1306_controller_t;
+
 typedef struct {
     // 1. Fundamental Command
     uint8_t contrast; // Value: 1-255
@@ -137,6 +257,7 @@ typedef struct {
     ssd1306_memory_addressing_mode_t memory_addressing_mode;
 
     // 4. Hardware Configuration Command
+    uint8_t start_line; // Values: 0-63, RAM row shown on the first panel row
     bool segment_re_map_inverse;
     uint8_t mux_ratio; // Values: 15-63
     bool com_output_scan_direction_remapped;
@@ -165,14 +286,161 @@ typedef enum {
     SSD1306_DISPLAY_SIZE_128x32 = 0x01,
 } ssd1306_display_size_t;
 
+typedef enum {
+    SSD1306_ROTATION_0 = 0x00, // As set up by config.segment_re_map_inverse and com_output_scan_direction_remapped
+    SSD1306_ROTATION_90 = 0x01, // Portrait, turned clockwise: the top of the picture along the right edge of the panel
+    SSD1306_ROTATION_180 = 0x02, // Upside down
+    SSD1306_ROTATION_270 = 0x03, // Portrait, turned counterclockwise: the top of the picture along the left edge of the panel
+} ssd1306_rotation_t;
+
+typedef enum {
+    SSD1306_DITHER_BAYER = 0x00, // Ordered 8x8 Bayer matrix, fastest, stable pattern for animated content
+    SSD1306_DITHER_FLOYD_STEINBERG = 0x01, // Error diffusion, smoothest gradients
+    SSD1306_DITHER_ATKINSON = 0x02, // Error diffusion that drops 1/4 of the error, more contrast
+} ssd1306_dither_t;
+
+typedef struct {
+    uint32_t calls;
+    uint64_t total_us;
+    uint32_t max_us;
+} ssd1306_timing_t;
+
+#define SSD1306_STATS_HISTOGRAM_BUCKETS 16
+
+typedef struct {
+    uint32_t command_bytes;
+    uint32_t command_transactions;
+    uint32_t data_bytes;
+    uint32_t data_transactions;
+    uint32_t frames_flushed;
+    uint32_t i2c_short_writes; // Transfer ended before all bytes were sent
+    uint32_t i2c_timeouts;
+    uint32_t i2c_naks; // Address or data not acknowledged
+    uint32_t flush_retries;
+    uint32_t controller_reinits; // Automatic re-initializations after a NAK storm
+    ssd1306_timing_t show;
+    ssd1306_timing_t print;
+    ssd1306_timing_t blit;
+    // Bucket N counts flushes that took [2^N, 2^(N+1)) us; bucket 0 also holds 0 us, the last bucket is open-ended.
+    uint32_t flush_latency_histogram[SSD1306_STATS_HISTOGRAM_BUCKETS];
+} ssd1306_stats_t;
+
+typedef struct {
+    uint8_t command;
+    uint8_t value;
+    bool has_value;
+} ssd1306_queued_command_t;
+
+typedef enum {
+    SSD1306_ALIGN_LEFT = 0x00,
+    SSD1306_ALIGN_CENTER = 0x01,
+    SSD1306_ALIGN_RIGHT = 0x02,
+} ssd1306_text_align_t;
+
+typedef struct {
+    ssd1306_text_align_t align; // Horizontal alignment of each line inside the box
+    uint8_t line_spacing; // Pixels between lines
+    bool ellipsis; // End the last line with "..." when the text does not fit the box
+} ssd1306_text_style_t;
+
+typedef struct {
+    uint16_t start; // Byte offset in the text
+    uint16_t length; // Bytes drawn, trailing spaces excluded
+    uint8_t width; // Pixels, including the ellipsis of a truncated last line
+} ssd1306_text_line_t;
+
+// Line breaks of one text for one box width, font and line limit
+typedef struct {
+    const char* text; // NULL = unused slot
+    uint16_t text_length;
+    uint16_t checksum; // Catches text rewritten in place, e.g. by snprintf() into the same buffer
+    const font_t* font;
+    uint8_t text_scale;
+    bool text_bold;
+    uint8_t box_width;
+    uint8_t max_lines;
+    bool ellipsis; // Requested by the style
+    bool truncated; // The last line is followed by an ellipsis
+    uint8_t line_count;
+    ssd1306_text_line_t lines[SSD1306_TEXT_BOX_LINES_MAX];
+} ssd1306_text_layout_t;
+
+typedef enum {
+    SSD1306_DISPLAY_LIST_BITMAP = 0x01,
+    SSD1306_DISPLAY_LIST_TEXT = 0x02,
+    SSD1306_DISPLAY_LIST_BITMAP_RECT = 0x03,
+} ssd1306_display_list_op_t;
+
+// Source rectangle and mask following a SSD1306_DISPLAY_LIST_BITMAP_RECT record
+typedef struct {
+    const uint8_t* mask;
+    uint8_t src_x;
+    uint8_t src_y;
+    uint8_t width;
+    uint8_t height;
+} ssd1306_display_list_rect_t;
+
+// One recorded draw call. A text record is followed by its NUL-terminated text, a bitmap rectangle
+// record by its ssd1306_display_list_rect_t, both padded to the record alignment.
+typedef struct {
+    uint8_t op; // ssd1306_display_list_op_t
+    uint8_t x;
+    uint8_t y;
+    // Clip rectangle at the time of the call
+    uint8_t clip_x0;
+    uint8_t clip_y0;
+    uint8_t clip_x1;
+    uint8_t clip_y1;
+    // Text style at the time of the call
+    uint8_t text_scale;
+    bool text_bold;
+    uint16_t text_size; // Bytes following the record, 0 for whole bitmaps
+    const void* source; // bitmap_t* or font_t*
+} ssd1306_display_list_entry_t;
+
 typedef struct {
     i2c_inst_t* i2c_inst;
     uint8_t i2c_address;
-    uint8_t width;
+    const ssd1306_controller_t* controller; // SSD1306 unless set with ssd1306_set_controller()
+    uint8_t width; // Of the framebuffer: the panel height when rotated by 90 or 270 degrees
     uint8_t height;
+    ssd1306_rotation_t rotation;
     const font_t* font;
+    const struct ssd1306_resident_arena* resident_arena; // SRAM copies drawn instead of flash assets, see ssd1306_resident.h
+    uint8_t text_scale; // Glyph magnification, 1 to SSD1306_TEXT_SCALE_MAX
+    bool text_bold; // Glyphs thickened by one pixel to the right
     uint16_t buffer_size;
     uint8_t* buffer;
+    // Drawing is limited to [clip_x0, clip_x1) x [clip_y0, clip_y1), the whole display by default.
+    uint8_t clip_x0;
+    uint8_t clip_y0;
+    uint8_t clip_x1;
+    uint8_t clip_y1;
+    // Page-streaming mode (ssd1306_create_streaming): buffer holds a single page and draw calls are recorded here.
+    uint8_t* display_list;
+    uint16_t display_list_size; // Bytes used
+    uint16_t display_list_capacity;
+    uint8_t buffer_page; // Page held at buffer + 1, always 0 with a full framebuffer
+    // Columns changed since the last flush, per page: [dirty_start, dirty_end). Page is clean when dirty_end == 0.
+    // Pages and columns are those of the panel; rotated by 90 or 270 degrees they cover whole 8x8 blocks.
+    uint8_t dirty_start[SSD1306_PAGES_MAX];
+    uint8_t dirty_end[SSD1306_PAGES_MAX];
+    uint32_t i2c_baudrate; // Used to compute per-transfer deadlines; 0 = fixed SSD1306_I2C_TIMEOUT_US
+    uint8_t consecutive_naks;
+    struct ssd1306_transfer_log* transfer_log; // While set, transfers are recorded here instead of sent (overlapped flush)
+    bool is_configured; // config holds the settings of the last successful ssd1306_init()
+    bool warm_start; // Set by ssd1306_init_warm(): the settings are persisted for the next soft reset
+    ssd1306_config_t config;
+    bool command_batching; // Setters queue commands until the next flush instead of sending them at once
+    uint8_t command_queue_len;
+    ssd1306_queued_command_t command_queue[SSD1306_COMMAND_QUEUE_CAPACITY];
+#if SSD1306_TEXT_LAYOUT_CACHE_SLOTS > 0
+    uint8_t text_layout_next; // Slot replaced by the next uncached text
+    ssd1306_text_layout_t text_layouts[SSD1306_TEXT_LAYOUT_CACHE_SLOTS];
+#endif
+#if SSD1306_ENABLE_STATS
+    ssd1306_stats_t stats;
+#endif
 } ssd1306_t;
 
 #endif // SSD1306_DEF_H
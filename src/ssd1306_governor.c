@@ -0,0 +1,124 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "pico/time.h"
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_governor.h"
+
+/**
+ * Create a frame-rate governor
+ * @param ssd1306
+ * @param target_fps (1-1000) Maximum flush rate
+ * @param latency_budget_us How long new content waits for further draws to coalesce with before it is flushed,
+ * at most one frame interval; 0 flushes as soon as the frame slot is open
+*/
+ssd1306_governor_t ssd1306_governor_create(ssd1306_t* ssd1306, uint16_t target_fps, uint32_t latency_budget_us) {
+    ssd1306_governor_t governor = {};
+    governor.ssd1306 = ssd1306;
+    governor.frame_interval_us = 1000000u / (target_fps > 0 ? target_fps : 1);
+    governor.latency_budget_us = latency_budget_us;
+    return governor;
+}
+
+static void ssd1306_governor_record(ssd1306_governor_t* governor, uint32_t frame_time_us) {
+    governor->frames++;
+    governor->frame_time_total_us += frame_time_us;
+    if (frame_time_us > governor->max_frame_time_us) {
+        governor->max_frame_time_us = frame_time_us;
+    }
+    governor->frame_times_us[governor->frame_times_next] = frame_time_us;
+    governor->frame_times_next = (governor->frame_times_next + 1) % SSD1306_GOVERNOR_HISTORY;
+    if (governor->frame_times_count < SSD1306_GOVERNOR_HISTORY) {
+        governor->frame_times_count++;
+    }
+}
+
+/**
+ * Call from the main loop as often as possible. Draw calls made between ticks are
+ * coalesced: the display is flushed only when the framebuffer is dirty or setter commands
+ * are queued, the content has waited the latency budget, and the frame interval has
+ * elapsed since the previous flush.
+ * @return false if the flush failed (content stays pending)
+*/
+bool ssd1306_governor_tick(ssd1306_governor_t* governor) {
+    if (governor == NULL || governor->ssd1306 == NULL) {
+        return false;
+    }
+
+    if (!ssd1306_is_dirty(governor->ssd1306) && governor->ssd1306->command_queue_len == 0) {
+        governor->pending = false;
+        return true;
+    }
+
+    const uint64_t now = time_us_64();
+    if (!governor->pending) {
+        governor->pending = true;
+        governor->pending_since_us = now;
+    }
+
+    // The flush is due when the content has waited the latency budget or when the frame slot opens, whichever is later.
+    const uint32_t wait = governor->latency_budget_us < governor->frame_interval_us ? governor->latency_budget_us : governor->frame_interval_us;
+    const uint64_t next_slot = governor->last_frame_us + governor->frame_interval_us;
+    const uint64_t due = (governor->pending_since_us + wait > next_slot) ? governor->pending_since_us + wait : next_slot;
+    if (now < due) {
+        return true;
+    }
+    governor->skipped_frames += (uint32_t)((now - due) / governor->frame_interval_us);
+
+    const bool is_ok = _ssd1306_show_pending(governor->ssd1306);
+    const uint64_t end = time_us_64();
+    governor->last_frame_us = now;
+    if (!is_ok) {
+        return false;
+    }
+
+    governor->pending = false;
+    ssd1306_governor_record(governor, (uint32_t)(end - now));
+    return true;
+}
+
+ssd1306_governor_stats_t ssd1306_governor_get_stats(const ssd1306_governor_t* governor) {
+    ssd1306_governor_stats_t stats = {};
+    if (governor == NULL || governor->frames == 0) {
+        return stats;
+    }
+
+    stats.frames = governor->frames;
+    stats.skipped_frames = governor->skipped_frames;
+    stats.mean_frame_time_us = (uint32_t)(governor->frame_time_total_us / governor->frames);
+    stats.max_frame_time_us = governor->max_frame_time_us;
+
+    // Insertion sort of the short history; this runs on demand, not per frame.
+    uint32_t sorted[SSD1306_GOVERNOR_HISTORY];
+    const uint16_t count = governor->frame_times_count;
+    for (uint16_t i = 0; i < count; i++) {
+        const uint32_t value = governor->frame_times_us[i];
+        uint16_t j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    stats.p99_frame_time_us = sorted[((uint32_t)count * 99 - 1) / 100];
+
+    return stats;
+}
+
+void ssd1306_governor_reset_stats(ssd1306_governor_t* governor) {
+    if (governor == NULL) {
+        return;
+    }
+    governor->frames = 0;
+    governor->skipped_frames = 0;
+    governor->frame_time_total_us = 0;
+    governor->max_frame_time_us = 0;
+    governor->frame_times_count = 0;
+    governor->frame_times_next = 0;
+}
@@ -0,0 +1,50 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_GOVERNOR_H
+#define SSD1306_GOVERNOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_def.h"
+
+#ifndef SSD1306_GOVERNOR_HISTORY
+// Number of recent frame times kept for the p99 estimate.
+#define SSD1306_GOVERNOR_HISTORY 128
+#endif
+
+typedef struct {
+    uint32_t frames; // Flushes performed
+    uint32_t skipped_frames; // Whole frame intervals a flush came later than it was due (ticks too far apart or a slow flush)
+    uint32_t mean_frame_time_us; // Mean ssd1306_show() duration
+    uint32_t p99_frame_time_us; // p99 ssd1306_show() duration over the last SSD1306_GOVERNOR_HISTORY frames
+    uint32_t max_frame_time_us;
+} ssd1306_governor_stats_t;
+
+typedef struct {
+    ssd1306_t* ssd1306;
+    uint32_t frame_interval_us;
+    uint32_t latency_budget_us;
+    uint64_t last_frame_us;
+    uint64_t pending_since_us;
+    bool pending;
+
+    // Statistics
+    uint32_t frames;
+    uint32_t skipped_frames;
+    uint64_t frame_time_total_us;
+    uint32_t max_frame_time_us;
+    uint32_t frame_times_us[SSD1306_GOVERNOR_HISTORY];
+    uint16_t frame_times_count;
+    uint16_t frame_times_next;
+} ssd1306_governor_t;
+
+ssd1306_governor_t ssd1306_governor_create(ssd1306_t* ssd1306, uint16_t target_fps, uint32_t latency_budget_us);
+bool ssd1306_governor_tick(ssd1306_governor_t* governor);
+ssd1306_governor_stats_t ssd1306_governor_get_stats(const ssd1306_governor_t* governor);
+void ssd1306_governor_reset_stats(ssd1306_governor_t* governor);
+
+#endif // SSD1306_GOVERNOR_H
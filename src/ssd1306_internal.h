@@ -0,0 +1,43 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+// Internal helpers shared by the library modules. Not part of the public API.
+
+#ifndef SSD1306_INTERNAL_H
+#define SSD1306_INTERNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ssd1306_def.h"
+
+// Transfer fed to an I2C controller's TX FIFO without blocking, see ssd1306_bus.c
+typedef struct {
+    i2c_inst_t* i2c_inst;
+    const uint8_t* data;
+    size_t len;
+    size_t queued; // Bytes written to the TX FIFO
+    bool is_aborted; // NAKed: the controller dropped the rest and sends STOP
+    uint64_t deadline_us;
+    int result; // Host build: outcome, known once the wire time has passed
+} ssd1306_bus_transfer_t;
+
+bool _ssd1306_send_commands(ssd1306_t* ssd1306, const uint8_t* commands, size_t len);
+bool _ssd1306_show_pending(ssd1306_t* ssd1306);
+bool _ssd1306_show_overlapped(ssd1306_t* const* displays, uint8_t count);
+bool _ssd1306_set_start_line_after_frame(ssd1306_t* ssd1306, uint8_t line);
+void _ssd1306_mark_dirty_area(ssd1306_t* ssd1306, uint8_t x, uint8_t y, uint16_t width, uint16_t height);
+bool _ssd1306_blit_rect(ssd1306_t* ssd1306, const uint8_t* data, const uint8_t* mask, uint16_t row_bytes, uint16_t src_x, uint16_t src_y, uint16_t width, uint16_t height, int16_t start_x, int16_t start_y);
+
+bool _ssd1306_blit_pages(ssd1306_t* ssd1306, const uint8_t* data, const uint8_t* mask, bool compressed, uint16_t width, uint16_t height, int16_t start_x, int16_t start_y);
+bool _ssd1306_print_at(ssd1306_t* ssd1306, const char* text, int16_t start_x, int16_t start_y);
+
+void _ssd1306_bus_start(ssd1306_bus_transfer_t* transfer, i2c_inst_t* i2c_inst, uint8_t address, const uint8_t* data, size_t len, uint32_t timeout_us);
+bool _ssd1306_bus_poll(ssd1306_bus_transfer_t* transfer, int* result);
+
+const void* _ssd1306_resident_find(const struct ssd1306_resident_arena* arena, const void* source);
+
+#endif // SSD1306_INTERNAL_H
@@ -0,0 +1,84 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include "pico/time.h"
+#include "ssd1306.h"
+#include "ssd1306_ramp.h"
+
+/**
+ * Create a contrast ramp. It does nothing until ssd1306_ramp_start().
+ * @param ssd1306
+*/
+ssd1306_ramp_t ssd1306_ramp_create(ssd1306_t* ssd1306) {
+    ssd1306_ramp_t ramp = {};
+    ramp.ssd1306 = ssd1306;
+    return ramp;
+}
+
+/**
+ * Move the contrast from its current value to contrast over duration_ms. A ramp that is still
+ * running continues from the contrast it has reached. Drive it with ssd1306_ramp_tick().
+ * @param contrast Target
+ * @param duration_ms 0 sets the target at once
+*/
+bool ssd1306_ramp_start(ssd1306_ramp_t* ramp, uint8_t contrast, uint32_t duration_ms) {
+    if (ramp == NULL || ramp->ssd1306 == NULL) {
+        return false;
+    }
+    ramp->from = ramp->ssd1306->config.contrast;
+    ramp->contrast = ramp->from;
+    ramp->to = contrast;
+    ramp->duration_us = (uint64_t)duration_ms * 1000u;
+    ramp->start_us = time_us_64();
+    ramp->last_step_us = ramp->start_us;
+    ramp->running = true;
+    if (ramp->duration_us == 0) {
+        return ssd1306_ramp_tick(ramp);
+    }
+    return true;
+}
+
+/**
+ * Call from the main loop or a timer callback that does not interrupt other transfers to the display.
+ * Sends the contrast for the elapsed time, at most one command per SSD1306_RAMP_STEP_INTERVAL_US and
+ * only when the value changed, so a ramp costs 3 bytes per step and no frame data. The last step
+ * sends the target.
+ * @return false if a contrast command failed (it is sent again on the next tick)
+*/
+bool ssd1306_ramp_tick(ssd1306_ramp_t* ramp) {
+    if (ramp == NULL || ramp->ssd1306 == NULL) {
+        return false;
+    }
+    if (!ramp->running) {
+        return true;
+    }
+    const uint64_t now = time_us_64();
+    const uint64_t elapsed = now - ramp->start_us;
+    const bool is_done = elapsed >= ramp->duration_us;
+    if (!is_done && now - ramp->last_step_us < SSD1306_RAMP_STEP_INTERVAL_US) {
+        return true;
+    }
+
+    uint8_t contrast = ramp->to;
+    if (!is_done) {
+        const int32_t delta = (int32_t)ramp->to - ramp->from;
+        contrast = (uint8_t)(ramp->from + (int32_t)((int64_t)delta * (int64_t)elapsed / (int64_t)ramp->duration_us));
+    }
+    if (contrast != ramp->contrast) {
+        ramp->last_step_us = now;
+        if (!ssd1306_set_contrast(ramp->ssd1306, contrast)) {
+            return false;
+        }
+        ramp->contrast = contrast;
+    }
+    ramp->running = !is_done;
+    return true;
+}
+
+bool ssd1306_ramp_is_running(const ssd1306_ramp_t* ramp) {
+    return ramp != NULL && ramp->running;
+}
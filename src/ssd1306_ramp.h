@@ -0,0 +1,36 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_RAMP_H
+#define SSD1306_RAMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_def.h"
+
+#ifndef SSD1306_RAMP_STEP_INTERVAL_US
+// Shortest time between two contrast commands of a ramp, 50 steps per second at most
+#define SSD1306_RAMP_STEP_INTERVAL_US 20000
+#endif
+
+// Contrast moved from its current value to a target over a duration, one contrast command per step
+typedef struct {
+    ssd1306_t* ssd1306;
+    uint8_t from;
+    uint8_t to;
+    uint8_t contrast; // Last value sent
+    uint64_t duration_us; // Up to UINT32_MAX ms, which does not fit 32 bits in microseconds
+    uint64_t start_us;
+    uint64_t last_step_us;
+    bool running;
+} ssd1306_ramp_t;
+
+ssd1306_ramp_t ssd1306_ramp_create(ssd1306_t* ssd1306);
+bool ssd1306_ramp_start(ssd1306_ramp_t* ramp, uint8_t contrast, uint32_t duration_ms);
+bool ssd1306_ramp_tick(ssd1306_ramp_t* ramp);
+bool ssd1306_ramp_is_running(const ssd1306_ramp_t* ramp);
+
+#endif // SSD1306_RAMP_H
@@ -0,0 +1,354 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "pico/time.h"
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_resident.h"
+
+/**
+ * Create an arena over caller-provided memory. Place it in SRAM (a static or stack array),
+ * pin the hot assets and attach it with ssd1306_resident_attach().
+ * @param memory
+ * @param capacity Bytes of memory
+*/
+ssd1306_resident_arena_t ssd1306_resident_arena_create(void* memory, size_t capacity) {
+    ssd1306_resident_arena_t arena = {};
+    arena.memory = (uint8_t*)memory;
+    arena.capacity = memory != NULL ? capacity : 0;
+    return arena;
+}
+
+/**
+ * Take size bytes, aligned for the structs and offset tables copied into them
+ * @return NULL if the arena is full
+*/
+static void* ssd1306_resident_alloc(ssd1306_resident_arena_t* arena, size_t size) {
+    const uintptr_t alignment = _Alignof(max_align_t);
+    const uintptr_t address = (uintptr_t)(arena->memory + arena->used);
+    const size_t start = arena->used + (size_t)(((address + alignment - 1) & ~(alignment - 1)) - address);
+    if (start > arena->capacity || size > arena->capacity - start) {
+        return NULL;
+    }
+    arena->used = start + size;
+    return arena->memory + start;
+}
+
+/**
+ * Copy of source taken from the arena
+*/
+static void* ssd1306_resident_copy(ssd1306_resident_arena_t* arena, const void* source, size_t size) {
+    void* copy = ssd1306_resident_alloc(arena, size);
+    if (copy != NULL) {
+        memcpy(copy, source, size);
+    }
+    return copy;
+}
+
+/**
+ * Walk PackBits data until it decodes to size bytes, storing them in out unless it is NULL
+ * @return bytes of PackBits data read
+*/
+static uint32_t ssd1306_resident_unpack(const uint8_t* data, uint32_t size, uint8_t* out) {
+    uint32_t read = 0;
+    uint32_t written = 0;
+    while (written < size) {
+        const uint8_t header = data[read++];
+        if (header == 0x80) {
+            continue; // No-op
+        }
+        const bool repeat = header > 0x80;
+        uint32_t count = repeat ? 257u - header : header + 1u;
+        const uint32_t stored = count < size - written ? count : size - written;
+        if (out != NULL) {
+            if (repeat) {
+                memset(out + written, data[read], stored);
+            } else {
+                memcpy(out + written, data + read, stored);
+            }
+        }
+        read += repeat ? 1 : count;
+        written += stored;
+    }
+    return read;
+}
+
+static uint32_t ssd1306_resident_pages_size(uint8_t width, uint8_t height) {
+    return (uint32_t)((height + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN) * width;
+}
+
+/**
+ * Bytes of one image (a glyph or a bitmap) in its format, after conversion to pages if to_pages is set
+*/
+static uint32_t ssd1306_resident_image_size(const uint8_t* data, uint8_t format, uint8_t width, uint8_t height, bool to_pages) {
+    if (to_pages || format == BITMAP_FORMAT_PAGES) {
+        return ssd1306_resident_pages_size(width, height);
+    }
+    if (format == BITMAP_FORMAT_ROWS) {
+        return (uint32_t)((width + 7) / 8) * height;
+    }
+    return ssd1306_resident_unpack(data, ssd1306_resident_pages_size(width, height), NULL);
+}
+
+/**
+ * Store one image at out, converted to BITMAP_FORMAT_PAGES if to_pages is set
+*/
+static void ssd1306_resident_store_image(const uint8_t* data, uint8_t format, uint8_t width, uint8_t height, bool to_pages, uint8_t* out) {
+    const uint32_t size = ssd1306_resident_image_size(data, format, width, height, to_pages);
+    if (!to_pages || format == BITMAP_FORMAT_PAGES) {
+        memcpy(out, data, size);
+    } else if (format == BITMAP_FORMAT_PAGES_RLE) {
+        ssd1306_resident_unpack(data, size, out);
+    } else {
+        // Rows: LSB = leftmost pixel. Pages: LSB = top row of the page.
+        const uint16_t row_bytes = (width + 7) / 8;
+        memset(out, 0, size);
+        for (uint16_t y = 0; y < height; y++) {
+            const uint8_t* row = data + (uint32_t)y * row_bytes;
+            uint8_t* column = out + (uint32_t)(y / SSD1306_BITS_PER_COLUMN) * width;
+            const uint8_t bit = (uint8_t)(1u << (y % SSD1306_BITS_PER_COLUMN));
+            for (uint16_t x = 0; x < width; x++) {
+                if (row[x / 8] & (1u << (x % 8))) {
+                    column[x] |= bit;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Copy an image into the arena
+ * @return the copy, NULL if the arena is full
+*/
+static uint8_t* ssd1306_resident_pin_image(ssd1306_resident_arena_t* arena, const uint8_t* data, uint8_t format, uint8_t width, uint8_t height, bool to_pages) {
+    uint8_t* copy = ssd1306_resident_alloc(arena, ssd1306_resident_image_size(data, format, width, height, to_pages));
+    if (copy != NULL) {
+        ssd1306_resident_store_image(data, format, width, height, to_pages, copy);
+    }
+    return copy;
+}
+
+/**
+ * Replace the glyph data, offsets, widths and codepoints of a subset copy with copies in the arena
+*/
+static bool ssd1306_resident_pin_subset(ssd1306_resident_arena_t* arena, const font_t* font, font_subset_t* subset, bool to_pages) {
+    const uint16_t count = subset->symbols_count;
+    uint32_t symbols_size = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        const uint8_t width = subset->widths != NULL ? subset->widths[i] : font->width;
+        symbols_size += ssd1306_resident_image_size(&subset->symbols[subset->offsets[i]], font->format, width, font->height, to_pages);
+    }
+
+    uint8_t* symbols = ssd1306_resident_alloc(arena, symbols_size);
+    uint32_t* offsets = ssd1306_resident_alloc(arena, count * sizeof(uint32_t));
+    const uint8_t* widths = subset->widths != NULL ? ssd1306_resident_copy(arena, subset->widths, count) : NULL;
+    const uint32_t* codepoints = subset->codepoints != NULL ? ssd1306_resident_copy(arena, subset->codepoints, count * sizeof(uint32_t)) : NULL;
+    if (symbols == NULL || offsets == NULL || (subset->widths != NULL && widths == NULL) || (subset->codepoints != NULL && codepoints == NULL)) {
+        return false;
+    }
+
+    uint32_t offset = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        const uint8_t width = subset->widths != NULL ? subset->widths[i] : font->width;
+        const uint8_t* glyph = &subset->symbols[subset->offsets[i]];
+        offsets[i] = offset;
+        ssd1306_resident_store_image(glyph, font->format, width, font->height, to_pages, symbols + offset);
+        offset += ssd1306_resident_image_size(glyph, font->format, width, font->height, to_pages);
+    }
+    subset->symbols = symbols;
+    subset->offsets = offsets;
+    subset->widths = widths;
+    subset->codepoints = codepoints;
+    return true;
+}
+
+static const void* ssd1306_resident_find_copy(const ssd1306_resident_arena_t* arena, const void* source) {
+    for (uint8_t i = 0; i < arena->entries_count; i++) {
+        if (arena->entries[i].source == source) {
+            return arena->entries[i].resident;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Record a finished copy, or give its memory back if it failed
+*/
+static const void* ssd1306_resident_register(ssd1306_resident_arena_t* arena, const void* source, const void* resident, size_t used_before) {
+    if (resident == NULL) {
+        arena->used = used_before;
+        return NULL;
+    }
+    ssd1306_resident_entry_t* entry = &arena->entries[arena->entries_count++];
+    entry->source = source;
+    entry->resident = resident;
+    entry->size = (uint32_t)(arena->used - used_before);
+    return resident;
+}
+
+static bool ssd1306_resident_has_room(const ssd1306_resident_arena_t* arena, const void* source) {
+    return arena != NULL && source != NULL && arena->entries_count < SSD1306_RESIDENT_ENTRIES_MAX;
+}
+
+/**
+ * Copy the lookup tables and glyphs of the subsets that cover any codepoint of [first, last]
+ * into the arena. Other subsets stay in flash, the copy of the font points to them.
+ * With to_pages the glyphs are converted to BITMAP_FORMAT_PAGES, which is drawn without bit
+ * reordering; the format is shared by all subsets, so then every subset is copied.
+ * @param first, last Codepoint range, 0 and UINT32_MAX for the whole font
+ * @return the copy in the arena (drawing with font uses it once the arena is attached), NULL if it does not fit
+*/
+const font_t* ssd1306_resident_pin_font(ssd1306_resident_arena_t* arena, const font_t* font, uint32_t first, uint32_t last, bool to_pages) {
+    if (!ssd1306_resident_has_room(arena, font) || font->subsets == NULL) {
+        return NULL;
+    }
+    const font_t* pinned = ssd1306_resident_find_copy(arena, font);
+    if (pinned != NULL) {
+        return pinned;
+    }
+
+    const size_t used = arena->used;
+    const bool is_converted = to_pages && font->format != BITMAP_FORMAT_PAGES;
+    font_t* copy = ssd1306_resident_copy(arena, font, sizeof(font_t));
+    font_subset_t* subsets = ssd1306_resident_copy(arena, font->subsets, font->subsets_count * sizeof(font_subset_t));
+    bool is_ok = copy != NULL && subsets != NULL;
+    for (uint16_t i = 0; is_ok && i < font->subsets_count; i++) {
+        if (is_converted || (subsets[i].start <= last && subsets[i].end >= first)) {
+            is_ok = ssd1306_resident_pin_subset(arena, font, &subsets[i], is_converted);
+        }
+    }
+    if (is_ok) {
+        copy->subsets = subsets;
+        copy->format = is_converted ? BITMAP_FORMAT_PAGES : font->format;
+    }
+    return ssd1306_resident_register(arena, font, is_ok ? copy : NULL, used);
+}
+
+/**
+ * Copy a bitmap into the arena, optionally converted to BITMAP_FORMAT_PAGES
+ * @return the copy, NULL if it does not fit
+*/
+const bitmap_t* ssd1306_resident_pin_bitmap(ssd1306_resident_arena_t* arena, const bitmap_t* bitmap, bool to_pages) {
+    if (!ssd1306_resident_has_room(arena, bitmap) || bitmap->data == NULL) {
+        return NULL;
+    }
+    const bitmap_t* pinned = ssd1306_resident_find_copy(arena, bitmap);
+    if (pinned != NULL) {
+        return pinned;
+    }
+
+    const size_t used = arena->used;
+    const bool is_converted = to_pages && bitmap->format != BITMAP_FORMAT_PAGES;
+    bitmap_t* copy = ssd1306_resident_copy(arena, bitmap, sizeof(bitmap_t));
+    const uint8_t* data = copy != NULL ? ssd1306_resident_pin_image(arena, bitmap->data, bitmap->format, bitmap->width, bitmap->height, is_converted) : NULL;
+    if (data != NULL) {
+        copy->data = data;
+        copy->format = is_converted ? BITMAP_FORMAT_PAGES : bitmap->format;
+    }
+    return ssd1306_resident_register(arena, bitmap, data != NULL ? copy : NULL, used);
+}
+
+/**
+ * Copy an atlas (sheet, mask and rectangles) into the arena, optionally converted to BITMAP_FORMAT_PAGES.
+ * The sheet is copied whole: one blit reads one sheet, so it cannot be split between flash and SRAM.
+ * @return the copy, NULL if it does not fit
+*/
+const bitmap_atlas_t* ssd1306_resident_pin_atlas(ssd1306_resident_arena_t* arena, const bitmap_atlas_t* atlas, bool to_pages) {
+    if (!ssd1306_resident_has_room(arena, atlas) || atlas->sheet.data == NULL || atlas->rects == NULL) {
+        return NULL;
+    }
+    const bitmap_atlas_t* pinned = ssd1306_resident_find_copy(arena, atlas);
+    if (pinned != NULL) {
+        return pinned;
+    }
+
+    const size_t used = arena->used;
+    const bitmap_t* sheet = &atlas->sheet;
+    const bool is_converted = to_pages && sheet->format != BITMAP_FORMAT_PAGES;
+    bitmap_atlas_t* copy = ssd1306_resident_copy(arena, atlas, sizeof(bitmap_atlas_t));
+    const uint8_t* data = copy != NULL ? ssd1306_resident_pin_image(arena, sheet->data, sheet->format, sheet->width, sheet->height, is_converted) : NULL;
+    const uint8_t* mask = (data != NULL && atlas->mask != NULL) ? ssd1306_resident_pin_image(arena, atlas->mask, sheet->format, sheet->width, sheet->height, is_converted) : NULL;
+    const bitmap_rect_t* rects = ssd1306_resident_copy(arena, atlas->rects, atlas->rects_count * sizeof(bitmap_rect_t));
+    const bool is_ok = data != NULL && (atlas->mask == NULL || mask != NULL) && rects != NULL;
+    if (is_ok) {
+        copy->sheet.data = data;
+        copy->sheet.format = is_converted ? BITMAP_FORMAT_PAGES : sheet->format;
+        copy->mask = mask;
+        copy->rects = rects;
+    }
+    return ssd1306_resident_register(arena, atlas, is_ok ? copy : NULL, used);
+}
+
+/**
+ * Copy pinned for source, or source itself
+*/
+const void* _ssd1306_resident_find(const ssd1306_resident_arena_t* arena, const void* source) {
+    const void* resident = ssd1306_resident_find_copy(arena, source);
+    return resident != NULL ? resident : source;
+}
+
+/**
+ * Draw from the copies in arena: ssd1306_print(), ssd1306_draw_bitmap(), ssd1306_draw_atlas()
+ * and the other bitmap functions look up the font, bitmap or atlas they are given in it.
+ * Pinning more assets later is picked up as well.
+ * @param arena NULL to draw from flash again
+*/
+void ssd1306_resident_attach(ssd1306_t* ssd1306, const ssd1306_resident_arena_t* arena) {
+    if (ssd1306 != NULL) {
+        ssd1306->resident_arena = arena;
+    }
+}
+
+/**
+ * Time one print with the given arena attached
+*/
+static uint32_t ssd1306_resident_time_print(ssd1306_t* ssd1306, const ssd1306_resident_arena_t* arena, const char* text, uint8_t x, uint8_t y, bool* is_ok) {
+    ssd1306->resident_arena = arena;
+    const uint64_t begin = time_us_64();
+    *is_ok = ssd1306_print(ssd1306, text, x, y) && *is_ok;
+    return (uint32_t)(time_us_64() - begin);
+}
+
+/**
+ * Print text repeat times from flash and repeat times from the attached arena, and report both times.
+ * One untimed print of each comes first, so the library code is in the XIP cache for both runs.
+ * The timed prints then alternate between flash and arena, and the one printed first changes
+ * every round, so neither run inherits a cache state from running before the other.
+ * The speedup is therefore what the glyph data costs in flash under the cache pressure of the
+ * application: measure where the text is printed, with the other core busy as usual.
+ * The text is left in the framebuffer.
+ * @return false without an attached arena, in page-streaming mode (prints are only recorded there) or if a print failed
+*/
+bool ssd1306_resident_measure_print(ssd1306_t* ssd1306, const char* text, uint8_t x, uint8_t y, uint16_t repeat, ssd1306_resident_report_t* report) {
+    if (ssd1306 == NULL || ssd1306->resident_arena == NULL || ssd1306->display_list != NULL || text == NULL || repeat == 0 || report == NULL) {
+        return false;
+    }
+    const ssd1306_resident_arena_t* arena = ssd1306->resident_arena;
+    bool is_ok = true;
+
+    ssd1306_resident_time_print(ssd1306, NULL, text, x, y, &is_ok);
+    ssd1306_resident_time_print(ssd1306, arena, text, x, y, &is_ok);
+
+    report->flash_us = 0;
+    report->resident_us = 0;
+    for (uint16_t i = 0; i < repeat; i++) {
+        if (i % 2 == 0) {
+            report->flash_us += ssd1306_resident_time_print(ssd1306, NULL, text, x, y, &is_ok);
+            report->resident_us += ssd1306_resident_time_print(ssd1306, arena, text, x, y, &is_ok);
+        } else {
+            report->resident_us += ssd1306_resident_time_print(ssd1306, arena, text, x, y, &is_ok);
+            report->flash_us += ssd1306_resident_time_print(ssd1306, NULL, text, x, y, &is_ok);
+        }
+    }
+    ssd1306->resident_arena = arena;
+
+    report->pinned_bytes = (uint32_t)arena->used;
+    const uint32_t speedup = report->resident_us > 0 ? (uint32_t)((uint64_t)report->flash_us * 100 / report->resident_us) : 0;
+    report->speedup_percent = speedup < UINT16_MAX ? (uint16_t)speedup : UINT16_MAX;
+    return is_ok;
+}
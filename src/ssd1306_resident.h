@@ -0,0 +1,49 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_RESIDENT_H
+#define SSD1306_RESIDENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ssd1306_def.h"
+
+#ifndef SSD1306_RESIDENT_ENTRIES_MAX
+// Fonts, bitmaps and atlases one arena can hold
+#define SSD1306_RESIDENT_ENTRIES_MAX 8
+#endif
+
+typedef struct {
+    const void* source; // font_t, bitmap_t or bitmap_atlas_t in flash
+    const void* resident; // Its copy in the arena, of the same type
+    uint32_t size; // Arena bytes taken by the copy
+} ssd1306_resident_entry_t;
+
+// SRAM copies of hot assets. Drawing with the flash asset uses the copy once the arena is attached.
+typedef struct ssd1306_resident_arena {
+    uint8_t* memory; // Caller-provided, e.g. a static array
+    size_t capacity;
+    size_t used;
+    uint8_t entries_count;
+    ssd1306_resident_entry_t entries[SSD1306_RESIDENT_ENTRIES_MAX];
+} ssd1306_resident_arena_t;
+
+typedef struct {
+    uint32_t pinned_bytes; // Arena bytes in use
+    uint32_t flash_us; // Time of the prints reading flash
+    uint32_t resident_us; // Time of the same prints reading the arena
+    uint16_t speedup_percent; // flash_us * 100 / resident_us: prints with warm code, alternating flash and arena
+} ssd1306_resident_report_t;
+
+ssd1306_resident_arena_t ssd1306_resident_arena_create(void* memory, size_t capacity);
+const font_t* ssd1306_resident_pin_font(ssd1306_resident_arena_t* arena, const font_t* font, uint32_t first, uint32_t last, bool to_pages);
+const bitmap_t* ssd1306_resident_pin_bitmap(ssd1306_resident_arena_t* arena, const bitmap_t* bitmap, bool to_pages);
+const bitmap_atlas_t* ssd1306_resident_pin_atlas(ssd1306_resident_arena_t* arena, const bitmap_atlas_t* atlas, bool to_pages);
+void ssd1306_resident_attach(ssd1306_t* ssd1306, const ssd1306_resident_arena_t* arena);
+bool ssd1306_resident_measure_print(ssd1306_t* ssd1306, const char* text, uint8_t x, uint8_t y, uint16_t repeat, ssd1306_resident_report_t* report);
+
+#endif // SSD1306_RESIDENT_H
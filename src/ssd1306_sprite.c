@@ -0,0 +1,212 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_sprite.h"
+
+ssd1306_sprite_t ssd1306_sprite_create(const bitmap_t* bitmap, const uint8_t* mask, int16_t x, int16_t y, uint8_t z) {
+    ssd1306_sprite_t sprite = {};
+    sprite.bitmap = bitmap;
+    sprite.mask = mask;
+    sprite.x = x;
+    sprite.y = y;
+    sprite.z = z;
+    sprite.visible = true;
+    return sprite;
+}
+
+/**
+ * Create a sprite layer
+ * @param ssd1306
+ * @param background Page-layout image restored under moving sprites, e.g. a copy of
+ *        ssd1306->buffer + 1 taken after drawing the static scene. NULL = blank background.
+*/
+ssd1306_sprite_layer_t ssd1306_sprite_layer_create(ssd1306_t* ssd1306, const uint8_t* background) {
+    ssd1306_sprite_layer_t layer = {};
+    layer.ssd1306 = ssd1306;
+    layer.background = background;
+    return layer;
+}
+
+/**
+ * Add the area of a rectangle to the per-page damage ranges, clipped to the display
+*/
+static void ssd1306_sprite_layer_damage(ssd1306_sprite_layer_t* layer, int16_t x, int16_t y, uint16_t width, uint16_t height) {
+    const ssd1306_t* ssd1306 = layer->ssd1306;
+    const int16_t x0 = x > 0 ? x : 0;
+    const int16_t y0 = y > 0 ? y : 0;
+    const int16_t x1 = (x + (int16_t)width) < ssd1306->width ? (x + (int16_t)width) : ssd1306->width;
+    const int16_t y1 = (y + (int16_t)height) < ssd1306->height ? (y + (int16_t)height) : ssd1306->height;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    for (int16_t page = y0 / SSD1306_BITS_PER_COLUMN; page <= (y1 - 1) / SSD1306_BITS_PER_COLUMN; page++) {
+        if (layer->damage_end[page] == 0) {
+            layer->damage_start[page] = (uint8_t)x0;
+            layer->damage_end[page] = (uint8_t)x1;
+            continue;
+        }
+        if (x0 < layer->damage_start[page]) {
+            layer->damage_start[page] = (uint8_t)x0;
+        }
+        if (x1 > layer->damage_end[page]) {
+            layer->damage_end[page] = (uint8_t)x1;
+        }
+    }
+}
+
+static void ssd1306_sprite_layer_damage_drawn(ssd1306_sprite_layer_t* layer, const ssd1306_sprite_t* sprite) {
+    if (sprite->drawn_visible && sprite->drawn_bitmap != NULL) {
+        ssd1306_sprite_layer_damage(layer, sprite->drawn_x, sprite->drawn_y, sprite->drawn_bitmap->width, sprite->drawn_bitmap->height);
+    }
+}
+
+static void ssd1306_sprite_layer_damage_current(ssd1306_sprite_layer_t* layer, const ssd1306_sprite_t* sprite) {
+    if (sprite->visible && sprite->bitmap != NULL) {
+        ssd1306_sprite_layer_damage(layer, sprite->x, sprite->y, sprite->bitmap->width, sprite->bitmap->height);
+    }
+}
+
+bool ssd1306_sprite_layer_add(ssd1306_sprite_layer_t* layer, ssd1306_sprite_t* sprite) {
+    if (layer == NULL || sprite == NULL || layer->count >= SSD1306_SPRITE_LAYER_CAPACITY) {
+        return false;
+    }
+    // Nothing of the sprite is on the framebuffer yet.
+    sprite->drawn_visible = false;
+    layer->sprites[layer->count++] = sprite;
+    return true;
+}
+
+void ssd1306_sprite_layer_remove(ssd1306_sprite_layer_t* layer, ssd1306_sprite_t* sprite) {
+    if (layer == NULL || sprite == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < layer->count; i++) {
+        if (layer->sprites[i] != sprite) {
+            continue;
+        }
+        ssd1306_sprite_layer_damage_drawn(layer, sprite);
+        sprite->drawn_visible = false;
+        memmove(&layer->sprites[i], &layer->sprites[i + 1], (layer->count - i - 1) * sizeof(layer->sprites[0]));
+        layer->count--;
+        return;
+    }
+}
+
+/**
+ * Recompose the whole display at the next compose, e.g. after changing the background
+*/
+void ssd1306_sprite_layer_invalidate(ssd1306_sprite_layer_t* layer) {
+    if (layer == NULL || layer->ssd1306 == NULL) {
+        return;
+    }
+    ssd1306_sprite_layer_damage(layer, 0, 0, layer->ssd1306->width, layer->ssd1306->height);
+}
+
+static bool ssd1306_sprite_is_changed(const ssd1306_sprite_t* sprite) {
+    return sprite->visible != sprite->drawn_visible ||
+        (sprite->visible && (sprite->x != sprite->drawn_x ||
+                             sprite->y != sprite->drawn_y ||
+                             sprite->z != sprite->drawn_z ||
+                             sprite->bitmap != sprite->drawn_bitmap ||
+                             sprite->mask != sprite->drawn_mask));
+}
+
+/**
+ * Redraw the page/column regions whose sprite set changed since the last compose:
+ * restore the background there and draw the intersecting sprites in z order.
+ * Only those regions are marked dirty, so the next ssd1306_show() sends just them.
+*/
+bool ssd1306_sprite_layer_compose(ssd1306_sprite_layer_t* layer) {
+    // Needs a full framebuffer, not available in page-streaming mode.
+    if (layer == NULL || layer->ssd1306 == NULL || layer->ssd1306->buffer == NULL || layer->ssd1306->display_list != NULL) {
+        return false;
+    }
+    ssd1306_t* ssd1306 = layer->ssd1306;
+
+    for (uint8_t i = 0; i < layer->count; i++) {
+        ssd1306_sprite_t* sprite = layer->sprites[i];
+        if (ssd1306_sprite_is_changed(sprite)) {
+            ssd1306_sprite_layer_damage_drawn(layer, sprite);
+            ssd1306_sprite_layer_damage_current(layer, sprite);
+        }
+    }
+
+    // Stable insertion sort by z; the list is short and mostly sorted between frames.
+    for (uint8_t i = 1; i < layer->count; i++) {
+        ssd1306_sprite_t* sprite = layer->sprites[i];
+        uint8_t j = i;
+        while (j > 0 && layer->sprites[j - 1]->z > sprite->z) {
+            layer->sprites[j] = layer->sprites[j - 1];
+            j--;
+        }
+        layer->sprites[j] = sprite;
+    }
+
+    const uint8_t clip[] = { ssd1306->clip_x0, ssd1306->clip_y0, ssd1306->clip_x1, ssd1306->clip_y1 };
+    const uint8_t pages = ssd1306->height / SSD1306_BITS_PER_COLUMN;
+    bool is_ok = true;
+
+    for (uint8_t page = 0; page < pages; page++) {
+        if (layer->damage_end[page] == 0) {
+            continue;
+        }
+        const uint8_t x0 = layer->damage_start[page];
+        const uint8_t columns = layer->damage_end[page] - x0;
+        const int16_t page_y = page * SSD1306_BITS_PER_COLUMN;
+        const uint16_t page_offset = (uint16_t)page * ssd1306->width + x0;
+
+        if (layer->background != NULL) {
+            memcpy(ssd1306->buffer + 1 + page_offset, layer->background + page_offset, columns);
+        } else {
+            memset(ssd1306->buffer + 1 + page_offset, 0, columns);
+        }
+        _ssd1306_mark_dirty_area(ssd1306, x0, (uint8_t)page_y, columns, SSD1306_BITS_PER_COLUMN);
+
+        ssd1306_set_clip(ssd1306, x0, (uint8_t)page_y, columns, SSD1306_BITS_PER_COLUMN);
+        for (uint8_t i = 0; i < layer->count; i++) {
+            const ssd1306_sprite_t* sprite = layer->sprites[i];
+            if (!sprite->visible || sprite->bitmap == NULL || sprite->bitmap->data == NULL) {
+                continue;
+            }
+            const bitmap_t* bitmap = sprite->bitmap;
+            if (sprite->y >= page_y + SSD1306_BITS_PER_COLUMN || sprite->y + bitmap->height <= page_y ||
+                sprite->x >= x0 + columns || sprite->x + bitmap->width <= x0) {
+                continue;
+            }
+            if (bitmap->format == BITMAP_FORMAT_ROWS) {
+                is_ok = _ssd1306_blit_rect(ssd1306, bitmap->data, sprite->mask, (bitmap->width + 7) / 8, 0, 0,
+                                           bitmap->width, bitmap->height, sprite->x, sprite->y) && is_ok;
+            } else {
+                is_ok = _ssd1306_blit_pages(ssd1306, bitmap->data, sprite->mask, bitmap->format == BITMAP_FORMAT_PAGES_RLE,
+                                            bitmap->width, bitmap->height, sprite->x, sprite->y) && is_ok;
+            }
+        }
+
+        layer->damage_end[page] = 0;
+    }
+
+    ssd1306->clip_x0 = clip[0];
+    ssd1306->clip_y0 = clip[1];
+    ssd1306->clip_x1 = clip[2];
+    ssd1306->clip_y1 = clip[3];
+
+    for (uint8_t i = 0; i < layer->count; i++) {
+        ssd1306_sprite_t* sprite = layer->sprites[i];
+        sprite->drawn_bitmap = sprite->bitmap;
+        sprite->drawn_mask = sprite->mask;
+        sprite->drawn_x = sprite->x;
+        sprite->drawn_y = sprite->y;
+        sprite->drawn_z = sprite->z;
+        sprite->drawn_visible = sprite->visible;
+    }
+
+    return is_ok;
+}
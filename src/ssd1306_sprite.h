@@ -0,0 +1,52 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_SPRITE_H
+#define SSD1306_SPRITE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306_def.h"
+
+#ifndef SSD1306_SPRITE_LAYER_CAPACITY
+#define SSD1306_SPRITE_LAYER_CAPACITY 16
+#endif
+
+typedef struct {
+    const bitmap_t* bitmap;
+    const uint8_t* mask; // Optional, same layout and compression as bitmap->data: 1 = opaque, 0 = transparent
+    int16_t x;
+    int16_t y;
+    uint8_t z; // Higher z is drawn on top
+    bool visible;
+
+    // State at the last compose, used to find damaged areas
+    const bitmap_t* drawn_bitmap;
+    const uint8_t* drawn_mask;
+    int16_t drawn_x;
+    int16_t drawn_y;
+    uint8_t drawn_z;
+    bool drawn_visible;
+} ssd1306_sprite_t;
+
+typedef struct {
+    ssd1306_t* ssd1306;
+    const uint8_t* background; // Page-layout image (width * height / 8 bytes) shown under sprites, NULL = blank
+    ssd1306_sprite_t* sprites[SSD1306_SPRITE_LAYER_CAPACITY];
+    uint8_t count;
+    // Columns to recompose per page: [damage_start, damage_end)
+    uint8_t damage_start[SSD1306_BUFFER_PAGES_MAX];
+    uint8_t damage_end[SSD1306_BUFFER_PAGES_MAX];
+} ssd1306_sprite_layer_t;
+
+ssd1306_sprite_t ssd1306_sprite_create(const bitmap_t* bitmap, const uint8_t* mask, int16_t x, int16_t y, uint8_t z);
+ssd1306_sprite_layer_t ssd1306_sprite_layer_create(ssd1306_t* ssd1306, const uint8_t* background);
+bool ssd1306_sprite_layer_add(ssd1306_sprite_layer_t* layer, ssd1306_sprite_t* sprite);
+void ssd1306_sprite_layer_remove(ssd1306_sprite_layer_t* layer, ssd1306_sprite_t* sprite);
+void ssd1306_sprite_layer_invalidate(ssd1306_sprite_layer_t* layer);
+bool ssd1306_sprite_layer_compose(ssd1306_sprite_layer_t* layer);
+
+#endif // SSD1306_SPRITE_H
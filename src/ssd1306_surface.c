@@ -0,0 +1,205 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "ssd1306.h"
+#include "ssd1306_internal.h"
+#include "ssd1306_surface.h"
+
+// Widest view: an ssd1306_t is at most 255 columns, so wider surfaces are drawn in column windows.
+#define SSD1306_SURFACE_VIEW_WIDTH_MAX 255
+
+/**
+ * Create a surface over caller-provided memory, e.g. a 128x512 menu or map:
+ * static uint8_t memory[SSD1306_SURFACE_SIZE(128, 512)].
+ * Draw on it with ssd1306_surface_print() and ssd1306_surface_draw_bitmap(), show a window of it with ssd1306_surface_blit().
+ * @param memory
+ * @param size Bytes of memory
+ * @param width Pixels
+ * @param height Pixels
+*/
+ssd1306_surface_t ssd1306_surface_create(void* memory, size_t size, uint16_t width, uint16_t height) {
+    ssd1306_surface_t surface = {};
+    if (memory == NULL || width == 0 || height == 0 || size < SSD1306_SURFACE_SIZE(width, height)) {
+        return surface;
+    }
+    surface.memory = (uint8_t*)memory;
+    surface.width = width;
+    surface.height = height;
+    surface.pages = (height + SSD1306_BITS_PER_COLUMN - 1) / SSD1306_BITS_PER_COLUMN;
+    return surface;
+}
+
+static bool ssd1306_surface_is_valid(const ssd1306_surface_t* surface) {
+    return surface != NULL && surface->memory != NULL && surface->width > 0;
+}
+
+/**
+ * Blank the surface
+*/
+bool ssd1306_surface_clear(ssd1306_surface_t* surface) {
+    if (!ssd1306_surface_is_valid(surface)) {
+        return false;
+    }
+    memset(surface->memory + 1, 0, (size_t)surface->width * surface->pages);
+    return true;
+}
+
+/**
+ * Pages one view covers. A view's rows are the surface rows only while it spans the whole width,
+ * so surfaces wider than a view are drawn one page at a time.
+*/
+static uint8_t ssd1306_surface_view_pages(const ssd1306_surface_t* surface) {
+    return surface->width <= SSD1306_SURFACE_VIEW_WIDTH_MAX ? SSD1306_PAGES_MAX : 1;
+}
+
+/**
+ * First column of the view window holding column x
+*/
+static uint16_t ssd1306_surface_view_column(uint16_t x) {
+    return x - x % SSD1306_SURFACE_VIEW_WIDTH_MAX;
+}
+
+/**
+ * Display-shaped view of the surface from first_page and first_column on, so the library drawing
+ * functions draw into the surface: up to SSD1306_PAGES_MAX pages of the whole width, or one page of
+ * up to SSD1306_SURFACE_VIEW_WIDTH_MAX columns of a wider surface. Its buffer starts one byte before
+ * the first pixel, where a framebuffer has its data control byte; drawing never writes that byte.
+*/
+static ssd1306_t ssd1306_surface_view(const ssd1306_surface_t* surface, uint16_t first_page, uint16_t first_column) {
+    const uint16_t pages_left = surface->pages - first_page;
+    const uint8_t view_pages = ssd1306_surface_view_pages(surface);
+    const uint8_t pages = pages_left < view_pages ? (uint8_t)pages_left : view_pages;
+    const uint16_t rows_left = surface->height - first_page * SSD1306_BITS_PER_COLUMN;
+    const uint16_t columns_left = surface->width - first_column;
+    ssd1306_t view = {};
+    view.width = columns_left < SSD1306_SURFACE_VIEW_WIDTH_MAX ? (uint8_t)columns_left : SSD1306_SURFACE_VIEW_WIDTH_MAX;
+    view.height = pages * SSD1306_BITS_PER_COLUMN;
+    view.rotation = SSD1306_ROTATION_0;
+    view.text_scale = 1;
+    view.buffer = surface->memory + (size_t)first_page * surface->width + first_column;
+    view.buffer_size = 1 + (uint16_t)pages * view.width;
+    // Rows past the surface height in its last page stay blank.
+    view.clip_x1 = view.width;
+    view.clip_y1 = rows_left < view.height ? (uint8_t)rows_left : view.height;
+    return view;
+}
+
+/**
+ * Print text with a font at scale 1. Text larger than a view is printed view by view.
+ * @param x, y Surface coordinates of the top left corner
+*/
+bool ssd1306_surface_print(ssd1306_surface_t* surface, const font_t* font, const char* text, uint16_t x, uint16_t y) {
+    if (!ssd1306_surface_is_valid(surface) || font == NULL || text == NULL) {
+        return false;
+    }
+    const uint32_t end_y = (uint32_t)y + font->height;
+    const uint8_t view_pages = ssd1306_surface_view_pages(surface);
+    bool is_ok = true;
+    for (uint16_t page = y / SSD1306_BITS_PER_COLUMN; page < surface->pages && (uint32_t)page * SSD1306_BITS_PER_COLUMN < end_y; page += view_pages) {
+        // The text width is not known up front: every window from the one holding x to the right edge
+        // gets the text, up to where the start position no longer fits the 16-bit coordinates.
+        for (uint32_t column = ssd1306_surface_view_column(x); column < surface->width && column < (uint32_t)x + INT16_MAX; column += SSD1306_SURFACE_VIEW_WIDTH_MAX) {
+            ssd1306_t view = ssd1306_surface_view(surface, page, (uint16_t)column);
+            view.font = font;
+            is_ok = _ssd1306_print_at(&view, text, (int16_t)(x - column), (int16_t)(y - page * SSD1306_BITS_PER_COLUMN)) && is_ok;
+        }
+    }
+    return is_ok;
+}
+
+/**
+ * Draw a bitmap in any format. Bitmaps larger than a view are drawn view by view as source rectangles.
+ * @param x, y Surface coordinates of the top left corner
+*/
+bool ssd1306_surface_draw_bitmap(ssd1306_surface_t* surface, const bitmap_t* bitmap, uint16_t x, uint16_t y) {
+    if (!ssd1306_surface_is_valid(surface) || bitmap == NULL || bitmap->data == NULL || bitmap->width == 0 || bitmap->height == 0) {
+        return false;
+    }
+    const uint32_t end_x = (uint32_t)x + bitmap->width;
+    const uint32_t end_y = (uint32_t)y + bitmap->height;
+    const uint8_t view_pages = ssd1306_surface_view_pages(surface);
+    bool is_ok = true;
+    for (uint16_t page = y / SSD1306_BITS_PER_COLUMN; page < surface->pages && (uint32_t)page * SSD1306_BITS_PER_COLUMN < end_y; page += view_pages) {
+        for (uint32_t column = ssd1306_surface_view_column(x); column < surface->width && column < end_x; column += SSD1306_SURFACE_VIEW_WIDTH_MAX) {
+            ssd1306_t view = ssd1306_surface_view(surface, page, (uint16_t)column);
+            const uint32_t view_y = (uint32_t)page * SSD1306_BITS_PER_COLUMN;
+            const uint32_t band_x0 = x > column ? x : column;
+            const uint32_t band_x1 = end_x < column + view.width ? end_x : column + view.width;
+            const uint32_t band_y0 = y > view_y ? y : view_y;
+            const uint32_t band_y1 = end_y < view_y + view.height ? end_y : view_y + view.height;
+            if (band_x0 >= band_x1) {
+                continue;
+            }
+            is_ok = ssd1306_draw_bitmap_rect(&view, bitmap, (uint8_t)(band_x0 - x), (uint8_t)(band_y0 - y), (uint8_t)(band_x1 - band_x0),
+                                             (uint8_t)(band_y1 - band_y0), (uint8_t)(band_x0 - column), (uint8_t)(band_y0 - view_y)) && is_ok;
+        }
+    }
+    return is_ok;
+}
+
+/**
+ * Copy a window of the surface into the framebuffer: display pixel (dx, dy) shows surface pixel
+ * (x + dx, y + dy). Only the clip rectangle is written, so a clip can keep a status bar out of the
+ * scrolling area; parts of the window outside the surface are blank.
+ * Each framebuffer byte is built from the two surface bytes that straddle its page with one shift
+ * each, so a one pixel scroll step costs a single pass over the window, not a redraw.
+ * @return false in page-streaming mode, which has no framebuffer to copy into
+*/
+bool ssd1306_surface_blit(ssd1306_t* ssd1306, const ssd1306_surface_t* surface, uint16_t x, uint16_t y) {
+    if (ssd1306 == NULL || ssd1306->buffer == NULL || ssd1306->display_list != NULL || !ssd1306_surface_is_valid(surface)) {
+        return false;
+    }
+    if (ssd1306->clip_x0 >= ssd1306->clip_x1 || ssd1306->clip_y0 >= ssd1306->clip_y1) {
+        return true;
+    }
+    const uint8_t* data = surface->memory + 1;
+    const uint8_t x0 = ssd1306->clip_x0;
+    const uint8_t x1 = ssd1306->clip_x1;
+    // Columns [x0, copy_x1) have surface pixels, the rest of the clip is past its right edge.
+    const uint16_t surface_x1 = x < surface->width ? (uint16_t)(surface->width - x) : 0;
+    const uint8_t copy_x1 = surface_x1 < x1 ? (surface_x1 > x0 ? (uint8_t)surface_x1 : x0) : x1;
+    const uint8_t first_page = ssd1306->clip_y0 / SSD1306_BITS_PER_COLUMN;
+    const uint8_t last_page = (ssd1306->clip_y1 - 1) / SSD1306_BITS_PER_COLUMN;
+
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        // Bits of the page outside the clip rows keep the framebuffer.
+        const uint8_t page_y0 = page * SSD1306_BITS_PER_COLUMN;
+        const uint8_t row0 = ssd1306->clip_y0 > page_y0 ? ssd1306->clip_y0 - page_y0 : 0;
+        const uint8_t row1 = ssd1306->clip_y1 - page_y0 < SSD1306_BITS_PER_COLUMN ? ssd1306->clip_y1 - page_y0 : SSD1306_BITS_PER_COLUMN;
+        const uint8_t keep = (uint8_t)~((0xFFu << row0) & (0xFFu >> (SSD1306_BITS_PER_COLUMN - row1)));
+
+        const uint32_t source_y = (uint32_t)y + page_y0;
+        const uint32_t source_page = source_y / SSD1306_BITS_PER_COLUMN;
+        const uint8_t shift = source_y % SSD1306_BITS_PER_COLUMN;
+        const bool has_upper = x < surface->width && source_page < surface->pages;
+        const uint8_t* upper = has_upper ? data + (size_t)source_page * surface->width + x : NULL;
+        const uint8_t* lower = (has_upper && shift != 0 && source_page + 1 < surface->pages) ? data + (size_t)(source_page + 1) * surface->width + x : NULL;
+        uint8_t* out = ssd1306->buffer + 1 + (uint16_t)page * ssd1306->width;
+
+        uint8_t column = x0;
+        if (keep == 0x00 && shift == 0 && upper != NULL) {
+            memcpy(out + x0, upper + x0, copy_x1 - x0);
+            column = copy_x1;
+        } else if (upper != NULL && lower != NULL) {
+            for (; column < copy_x1; column++) {
+                const uint8_t value = (uint8_t)((upper[column] >> shift) | (lower[column] << (SSD1306_BITS_PER_COLUMN - shift)));
+                out[column] = (out[column] & keep) | (value & (uint8_t)~keep);
+            }
+        } else if (upper != NULL) {
+            for (; column < copy_x1; column++) {
+                const uint8_t value = (uint8_t)(upper[column] >> shift);
+                out[column] = (out[column] & keep) | (value & (uint8_t)~keep);
+            }
+        }
+        for (; column < x1; column++) {
+            out[column] &= keep;
+        }
+    }
+    _ssd1306_mark_dirty_area(ssd1306, x0, ssd1306->clip_y0, x1 - x0, ssd1306->clip_y1 - ssd1306->clip_y0);
+    return true;
+}
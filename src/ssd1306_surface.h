@@ -0,0 +1,32 @@
+/**
+ * C Library for SSD1306 OLED Display
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_SURFACE_H
+#define SSD1306_SURFACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "ssd1306_def.h"
+
+// Bytes of memory a width x height surface needs: its pages plus one reserved byte
+#define SSD1306_SURFACE_SIZE(width, height) (1 + (size_t)(width) * (((height) + 7) / 8))
+
+// Off-screen 1bpp image in page layout (bit n of a byte = row n of its page), larger than the display
+typedef struct {
+    uint8_t* memory; // Caller-provided, SSD1306_SURFACE_SIZE() bytes. Pixels start at memory + 1.
+    uint16_t width; // 0 if the memory is too small
+    uint16_t height;
+    uint16_t pages;
+} ssd1306_surface_t;
+
+ssd1306_surface_t ssd1306_surface_create(void* memory, size_t size, uint16_t width, uint16_t height);
+bool ssd1306_surface_clear(ssd1306_surface_t* surface);
+bool ssd1306_surface_print(ssd1306_surface_t* surface, const font_t* font, const char* text, uint16_t x, uint16_t y);
+bool ssd1306_surface_draw_bitmap(ssd1306_surface_t* surface, const bitmap_t* bitmap, uint16_t x, uint16_t y);
+bool ssd1306_surface_blit(ssd1306_t* ssd1306, const ssd1306_surface_t* surface, uint16_t x, uint16_t y);
+
+#endif // SSD1306_SURFACE_H
@@ -0,0 +1,83 @@
+# ssd1306_add_assets(<target> NAME <c_name> SOURCE <file>
+#                    [FORMAT ROWS|PAGES] [RLE] [SIZE <px>]
+#                    [CHARS <string>] [CHARS_FILE <file>...]
+#                    [LETTER_SPACING <px>] [WORD_SPACING <px>] [THRESHOLD <0-255>] [INVERT]
+#                    [FRAME_MS <ms>] [LOOP] [ATLAS_WIDTH <px>])
+#
+# Converts a font (BDF, TTF/OTF), an image (PNG, PBM), an animation (.anim manifest of frame images)
+# or an icon atlas (.atlas manifest of icon images) at build time into <c_name>.c/<c_name>.h,
+# adds the source to <target> and its directory to the include path. Call once per asset.
+# With CHARS/CHARS_FILE only glyphs of the given characters are compiled in.
+
+set(SSD1306_ASSETS_TOOL ${CMAKE_CURRENT_LIST_DIR}/ssd1306_assets.py CACHE INTERNAL "pico-ssd1306 asset compiler")
+
+function(ssd1306_add_assets target)
+    cmake_parse_arguments(ASSET "RLE;INVERT;LOOP" "NAME;SOURCE;FORMAT;SIZE;CHARS;LETTER_SPACING;WORD_SPACING;THRESHOLD;FRAME_MS;ATLAS_WIDTH" "CHARS_FILE" ${ARGN})
+    if (NOT ASSET_NAME OR NOT ASSET_SOURCE)
+        message(FATAL_ERROR "ssd1306_add_assets: NAME and SOURCE are required")
+    endif()
+    if (NOT Python3_EXECUTABLE)
+        find_package(Python3 REQUIRED COMPONENTS Interpreter)
+    endif()
+
+    get_filename_component(source ${ASSET_SOURCE} ABSOLUTE)
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/ssd1306_assets)
+    set(args ${source} --name ${ASSET_NAME} --out-dir ${out_dir})
+    set(depends ${source} ${SSD1306_ASSETS_TOOL})
+
+    if (ASSET_FORMAT)
+        string(TOLOWER ${ASSET_FORMAT} format)
+        list(APPEND args --format ${format})
+    endif()
+    if (ASSET_RLE)
+        list(APPEND args --rle)
+    endif()
+    if (ASSET_INVERT)
+        list(APPEND args --invert)
+    endif()
+    if (ASSET_LOOP)
+        list(APPEND args --loop)
+    endif()
+    foreach (option SIZE LETTER_SPACING WORD_SPACING THRESHOLD FRAME_MS ATLAS_WIDTH)
+        if (DEFINED ASSET_${option})
+            string(TOLOWER ${option} flag)
+            string(REPLACE "_" "-" flag ${flag})
+            list(APPEND args --${flag} ${ASSET_${option}})
+        endif()
+    endforeach()
+    if (DEFINED ASSET_CHARS)
+        list(APPEND args --chars ${ASSET_CHARS})
+    endif()
+    foreach (chars_file ${ASSET_CHARS_FILE})
+        get_filename_component(chars_file ${chars_file} ABSOLUTE)
+        list(APPEND args --chars-file ${chars_file})
+        list(APPEND depends ${chars_file})
+    endforeach()
+
+    # Frames of an animation and icons of an atlas are listed in its manifest, rerun when any of them changes.
+    get_filename_component(source_ext ${source} LAST_EXT)
+    if (source_ext STREQUAL ".anim" OR source_ext STREQUAL ".atlas")
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${source})
+        get_filename_component(source_dir ${source} DIRECTORY)
+        file(STRINGS ${source} manifest_lines)
+        foreach (line ${manifest_lines})
+            string(REGEX REPLACE "#.*" "" line "${line}")
+            string(STRIP "${line}" line)
+            if (line)
+                string(REGEX REPLACE "[ \t].*" "" frame "${line}")
+                list(APPEND depends ${source_dir}/${frame})
+            endif()
+        endforeach()
+    endif()
+
+    add_custom_command(
+        OUTPUT ${out_dir}/${ASSET_NAME}.c ${out_dir}/${ASSET_NAME}.h
+        COMMAND ${Python3_EXECUTABLE} ${SSD1306_ASSETS_TOOL} ${args}
+        DEPENDS ${depends}
+        COMMENT "Compiling SSD1306 asset ${ASSET_NAME}"
+        VERBATIM
+    )
+    target_sources(${target} PRIVATE ${out_dir}/${ASSET_NAME}.c ${out_dir}/${ASSET_NAME}.h)
+    # Generated sources include bitmap.h/font.h, so <target> must link pico_ssd1306.
+    target_include_directories(${target} PRIVATE ${out_dir})
+endfunction()
@@ -0,0 +1,727 @@
+#!/usr/bin/env python3
+"""
+Asset compiler for pico-ssd1306.
+
+Converts a font (BDF, or TTF/OTF with the freetype-py package), an image
+(PNG, PBM), an animation (.anim manifest of images) or an icon atlas (.atlas
+manifest of images) into a C source/header pair defining a font_t, bitmap_t,
+ssd1306_animation_t or bitmap_atlas_t:
+
+    ssd1306_assets.py font.bdf --name my_font --out-dir build/assets --chars-file ui_strings.txt
+    ssd1306_assets.py logo.png --name logo --out-dir build/assets --format pages --rle
+    ssd1306_assets.py boot.anim --name boot --out-dir build/assets --loop
+    ssd1306_assets.py icons.atlas --name icons --out-dir build/assets --format pages
+
+An .anim manifest lists one frame image per line, optionally followed by the
+frame duration in milliseconds (default --frame-ms). An .atlas manifest lists
+one icon image per line. Paths are relative to the manifest, lines starting
+with # are comments.
+
+<name>.h declares the asset and can be included from any number of translation
+units; <name>.c holds the data. Usually called through ssd1306_add_assets() in CMake.
+
+Author: Pavel Koltyshev
+(c) 2025
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+FORMAT_ROWS = 0
+FORMAT_PAGES = 1
+FORMAT_PAGES_RLE = 2
+FORMAT_NAMES = {
+    FORMAT_ROWS: "BITMAP_FORMAT_ROWS",
+    FORMAT_PAGES: "BITMAP_FORMAT_PAGES",
+    FORMAT_PAGES_RLE: "BITMAP_FORMAT_PAGES_RLE",
+}
+MAX_CODEPOINT = 0x10FFFF
+ANIMATION_RUN_GAP_MAX = 3  # Unchanged columns between two runs cheaper to resend than a run header
+CONTIGUOUS_RUN_MIN = 12  # Shorter runs are cheaper in the sparse subset (4 index bytes per glyph vs. one subset)
+
+
+class AssetError(Exception):
+    pass
+
+
+# ---------------------------------------------------------------------------
+# Pixel encodings. An image is a list of rows, each a list of 0/1 pixels.
+
+def encode_rows(pixels, width):
+    """Rows of ceil(width / 8) bytes, LSB = leftmost pixel."""
+    out = bytearray()
+    for row in pixels:
+        line = bytearray((width + 7) // 8)
+        for x in range(width):
+            if row[x]:
+                line[x // 8] |= 1 << (x % 8)
+        out += line
+    return bytes(out)
+
+
+def encode_pages(pixels, width):
+    """For each 8-row page, one byte per column, LSB = top row of the page."""
+    height = len(pixels)
+    out = bytearray()
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            value = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and pixels[y][x]:
+                    value |= 1 << bit
+            out.append(value)
+    return bytes(out)
+
+
+def packbits(data):
+    """PackBits: header 0-127 = copy header + 1 literal bytes, 129-255 = repeat next byte 257 - header times."""
+    out = bytearray()
+    i = 0
+    n = len(data)
+    while i < n:
+        run = 1
+        while i + run < n and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            out += bytes((257 - run, data[i]))
+            i += run
+            continue
+        j = i
+        while j < n and j - i < 128 and not (j + 1 < n and data[j] == data[j + 1]):
+            j += 1
+        out.append(j - i - 1)
+        out += data[i:j]
+        i = j
+    return bytes(out)
+
+
+def encode(pixels, width, fmt):
+    if fmt == FORMAT_ROWS:
+        return encode_rows(pixels, width)
+    data = encode_pages(pixels, width)
+    return packbits(data) if fmt == FORMAT_PAGES_RLE else data
+
+
+# ---------------------------------------------------------------------------
+# Image readers
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path, threshold, invert):
+    with open(path, "rb") as f:
+        blob = f.read()
+    if blob[:8] != b"\x89PNG\r\n\x1a\n":
+        raise AssetError(f"{path}: not a PNG file")
+
+    pos = 8
+    header = None
+    palette = []
+    transparency = b""
+    idat = bytearray()
+    while pos < len(blob):
+        length, kind = struct.unpack(">I4s", blob[pos:pos + 8])
+        chunk = blob[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            header = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            transparency = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+    if header is None:
+        raise AssetError(f"{path}: missing IHDR")
+
+    width, height, depth, color, _, _, interlace = header
+    if interlace:
+        raise AssetError(f"{path}: interlaced PNG is not supported")
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color)
+    if channels is None:
+        raise AssetError(f"{path}: unsupported PNG color type {color}")
+
+    raw = zlib.decompress(bytes(idat))
+    bits_per_pixel = depth * channels
+    stride = (width * bits_per_pixel + 7) // 8
+    step = max(1, bits_per_pixel // 8)
+    previous = bytearray(stride)
+    pixels = []
+    opaque = []
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            left = line[i - step] if i >= step else 0
+            up = previous[i]
+            upper_left = previous[i - step] if i >= step else 0
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+            elif kind == 4:
+                line[i] = (line[i] + paeth(left, up, upper_left)) & 0xFF
+        previous = line
+
+        def sample(index):
+            # Channel `index` of the row scaled to 0-255.
+            if depth == 8:
+                return line[index]
+            if depth == 16:
+                return line[index * 2]
+            per_byte = 8 // depth
+            value = (line[index // per_byte] >> (8 - depth - (index % per_byte) * depth)) & ((1 << depth) - 1)
+            return value if color == 3 else value * 255 // ((1 << depth) - 1)
+
+        row = []
+        opaque_row = []
+        for x in range(width):
+            alpha = 255
+            if color == 3:
+                index = sample(x)
+                r, g, b = palette[index] if index < len(palette) else (0, 0, 0)
+                if index < len(transparency):
+                    alpha = transparency[index]
+            elif color in (0, 4):
+                r = g = b = sample(x * channels)
+                if color == 4:
+                    alpha = sample(x * channels + 1)
+            else:
+                r, g, b = (sample(x * channels + c) for c in range(3))
+                if color == 6:
+                    alpha = sample(x * channels + 3)
+            luminance = (r * 299 + g * 587 + b * 114) // 1000
+            on = luminance >= threshold
+            if invert:
+                on = not on
+            row.append(1 if on and alpha >= 128 else 0)
+            opaque_row.append(1 if alpha >= 128 else 0)
+        pixels.append(row)
+        opaque.append(opaque_row)
+    return width, height, pixels, opaque
+
+
+def read_pbm(path, invert):
+    """P1/P4 bitmap, 1 = pixel on (same as the emulator output)."""
+    with open(path, "rb") as f:
+        blob = f.read()
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        while blob[pos:pos + 1].isspace():
+            pos += 1
+        if blob[pos:pos + 1] == b"#":
+            pos = blob.index(b"\n", pos)
+            continue
+        start = pos
+        while not blob[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(blob[start:pos].decode())
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    pos += 1
+    if magic == "P4":
+        stride = (width + 7) // 8
+        pixels = [[(blob[pos + y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)] for y in range(height)]
+    elif magic == "P1":
+        bits = [int(c) for c in blob[pos:].decode() if c in "01"]
+        pixels = [bits[y * width:(y + 1) * width] for y in range(height)]
+    else:
+        raise AssetError(f"{path}: unsupported PBM type {magic}")
+    if invert:
+        pixels = [[1 - p for p in row] for row in pixels]
+    return width, height, pixels, [[1] * width for _ in range(height)]
+
+
+# ---------------------------------------------------------------------------
+# Font readers. A glyph is (advance, rows of 0/1 pixels, each `advance` wide).
+
+def read_bdf(path):
+    glyphs = {}
+    ascent = descent = None
+    box_height = box_descent = 0
+    with open(path, "r", encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == "FONTBOUNDINGBOX":
+            box_height, box_descent = int(words[2]), -int(words[4])
+        elif words[0] == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif words[0] == "FONT_DESCENT":
+            descent = int(words[1])
+        elif words[0] == "STARTCHAR":
+            codepoint = -1
+            advance = 0
+            bbx = (0, 0, 0, 0)
+            for line in lines:
+                words = line.split()
+                if not words:
+                    continue
+                if words[0] == "ENCODING":
+                    codepoint = int(words[1])  # -1: glyph without a standard encoding
+                elif words[0] == "DWIDTH":
+                    advance = int(words[1])
+                elif words[0] == "BBX":
+                    bbx = tuple(int(w) for w in words[1:5])
+                elif words[0] == "BITMAP":
+                    rows = []
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        hex_row = line.strip()
+                        rows.append((int(hex_row, 16) if hex_row else 0, len(hex_row) * 4))
+                    if codepoint >= 0:
+                        glyphs[codepoint] = (advance, bbx, rows)
+                    break
+    if ascent is None:
+        ascent = box_height - box_descent
+    if descent is None:
+        descent = box_descent
+
+    height = ascent + descent
+    result = {}
+    for codepoint, (advance, (w, h, xoff, yoff), rows) in glyphs.items():
+        pixels = [[0] * advance for _ in range(height)]
+        for gy, (bits, row_bits) in enumerate(rows[:h]):
+            y = ascent - (yoff + h) + gy
+            if not 0 <= y < height:
+                continue
+            for gx in range(w):
+                x = xoff + gx
+                if 0 <= x < advance and (bits >> (row_bits - 1 - gx)) & 1:
+                    pixels[y][x] = 1
+        result[codepoint] = (advance, pixels)
+    return height, result
+
+
+def read_freetype(path, size, codepoints):
+    try:
+        import freetype
+    except ImportError:
+        raise AssetError(f"{path}: TTF/OTF fonts need the freetype-py package (pip install freetype-py)")
+    if not size:
+        raise AssetError(f"{path}: SIZE (pixel height) is required for TTF/OTF fonts")
+
+    face = freetype.Face(path)
+    face.set_pixel_sizes(0, size)
+    ascent = (face.size.ascender + 63) >> 6
+    descent = (-face.size.descender + 63) >> 6
+    height = ascent + descent
+    if codepoints is None:
+        codepoints = range(0x20, 0x7F)
+
+    result = {}
+    for codepoint in codepoints:
+        if face.get_char_index(codepoint) == 0:
+            continue
+        face.load_char(chr(codepoint), freetype.FT_LOAD_RENDER | freetype.FT_LOAD_TARGET_MONO)
+        glyph = face.glyph
+        bitmap = glyph.bitmap
+        advance = (glyph.advance.x + 32) >> 6
+        pixels = [[0] * advance for _ in range(height)]
+        for gy in range(bitmap.rows):
+            y = ascent - glyph.bitmap_top + gy
+            if not 0 <= y < height:
+                continue
+            for gx in range(bitmap.width):
+                x = glyph.bitmap_left + gx
+                if 0 <= x < advance and (bitmap.buffer[gy * bitmap.pitch + gx // 8] >> (7 - gx % 8)) & 1:
+                    pixels[y][x] = 1
+        result[codepoint] = (advance, pixels)
+    return height, result
+
+
+# ---------------------------------------------------------------------------
+# C output
+
+def c_bytes(data, indent="    "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def c_words(values, per_line=8, indent="    "):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def write_outputs(out_dir, name, source, include, declaration, body, defines=""):
+    os.makedirs(out_dir, exist_ok=True)
+    banner = f"// Generated by ssd1306_assets.py from {os.path.basename(source)}. Do not edit.\n"
+    guard = f"SSD1306_ASSET_{name.upper()}_H"
+    header = (f"{banner}\n#ifndef {guard}\n#define {guard}\n\n#include \"{include}\"\n\n{defines}"
+              f"extern {declaration};\n\n#endif // {guard}\n")
+    source_text = f"{banner}\n#include <stddef.h>\n#include <stdint.h>\n#include \"{name}.h\"\n\n{body}"
+    for path, text in ((os.path.join(out_dir, f"{name}.h"), header), (os.path.join(out_dir, f"{name}.c"), source_text)):
+        # Keep the timestamp when nothing changed, so dependent objects are not rebuilt.
+        if os.path.exists(path):
+            with open(path, "r", encoding="utf-8") as f:
+                if f.read() == text:
+                    continue
+        with open(path, "w", encoding="utf-8") as f:
+            f.write(text)
+
+
+def read_image_with_mask(path, args):
+    """Width, height, pixels and opacity (alpha >= 128; PBM images are opaque)."""
+    if os.path.splitext(path)[1].lower() == ".png":
+        return read_png(path, args.threshold, args.invert)
+    return read_pbm(path, args.invert)
+
+
+def read_image(path, args):
+    return read_image_with_mask(path, args)[:3]
+
+
+def compile_bitmap(args, fmt):
+    width, height, pixels = read_image(args.source, args)
+    if not (0 < width <= 255 and 0 < height <= 255):
+        raise AssetError(f"{args.source}: {width}x{height} is outside the 1-255 pixel range of bitmap_t")
+
+    data = encode(pixels, width, fmt)
+    body = (f"static const uint8_t {args.name}_data[] = {{\n{c_bytes(data)}\n}};\n\n"
+            f"const bitmap_t {args.name} = {{\n"
+            f"    .width = {width},\n"
+            f"    .height = {height},\n"
+            f"    .data = {args.name}_data,\n"
+            f"    .format = {FORMAT_NAMES[fmt]},\n"
+            f"}};\n")
+    write_outputs(args.out_dir, args.name, args.source, "bitmap.h", f"const bitmap_t {args.name}", body)
+    return len(data)
+
+
+def read_animation_manifest(path, frame_ms):
+    """(image path, duration in ms) for each frame line of an .anim manifest."""
+    frames = []
+    base = os.path.dirname(os.path.abspath(path))
+    with open(path, "r", encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            if len(fields) > 2 or (len(fields) == 2 and not fields[1].isdigit()):
+                raise AssetError(f"{path}:{number}: expected '<image> [duration_ms]'")
+            duration = int(fields[1]) if len(fields) == 2 else frame_ms
+            if duration > 0xFFFF:
+                raise AssetError(f"{path}:{number}: duration {duration} ms is above 65535")
+            frames.append((os.path.join(base, fields[0]), duration))
+    if not frames:
+        raise AssetError(f"{path}: no frames")
+    if len(frames) > 0xFFFF:
+        raise AssetError(f"{path}: more than 65535 frames")
+    return frames
+
+
+def encode_frame_delta(previous, current, width, duration):
+    """Frame of the runs of page bytes that differ from the previous frame (see ssd1306_animation.h)."""
+    runs = bytearray()
+    runs_count = 0
+    for page in range(len(current) // width):
+        row = page * width
+        changed = [x for x in range(width) if current[row + x] != previous[row + x]]
+        start = 0
+        while start < len(changed):
+            end = start
+            # Short gaps are sent along: a run header costs more than the unchanged bytes.
+            while (end + 1 < len(changed) and changed[end + 1] - changed[end] <= ANIMATION_RUN_GAP_MAX + 1
+                   and changed[end + 1] - changed[start] < 255):
+                end += 1
+            x0, x1 = changed[start], changed[end] + 1
+            runs += bytes((page, x0, x1 - x0)) + current[row + x0:row + x1]
+            runs_count += 1
+            start = end + 1
+    return struct.pack("<HH", duration, runs_count) + bytes(runs)
+
+
+def compile_animation(args):
+    frames = read_animation_manifest(args.source, args.frame_ms)
+    images = []
+    width = height = None
+    for path, duration in frames:
+        frame_width, frame_height, pixels = read_image(path, args)
+        if width is None:
+            width, height = frame_width, frame_height
+        elif (frame_width, frame_height) != (width, height):
+            raise AssetError(f"{path}: {frame_width}x{frame_height} differs from the first frame ({width}x{height})")
+        images.append(encode_pages(pixels, width))
+    if not (0 < width <= 255 and 0 < height <= 255):
+        raise AssetError(f"{args.source}: {width}x{height} is outside the 1-255 pixel range")
+
+    data = bytearray()
+    previous = bytes(len(images[0]))
+    for image, (_, duration) in zip(images, frames):
+        data += encode_frame_delta(previous, image, width, duration)
+        previous = image
+    loop_offset = 0
+    if args.loop:
+        loop_offset = len(data)
+        data += encode_frame_delta(previous, images[0], width, frames[0][1])
+
+    body = (f"static const uint8_t {args.name}_data[] = {{\n{c_bytes(data)}\n}};\n\n"
+            f"const ssd1306_animation_t {args.name} = {{\n"
+            f"    .width = {width},\n"
+            f"    .height = {height},\n"
+            f"    .frames_count = {len(frames)},\n"
+            f"    .size = {len(data)},\n"
+            f"    .loop_offset = {loop_offset},\n"
+            f"    .data = {args.name}_data,\n"
+            f"}};\n")
+    write_outputs(args.out_dir, args.name, args.source, "ssd1306_animation.h", f"const ssd1306_animation_t {args.name}", body)
+    print(f"ssd1306_assets: {args.name} (animation, {len(frames)} frames): {len(data)} bytes, "
+          f"{len(images[0]) * len(frames)} as full frames")
+
+
+def read_atlas_manifest(path):
+    """Image path of each icon line of an .atlas manifest."""
+    images = []
+    base = os.path.dirname(os.path.abspath(path))
+    with open(path, "r", encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            if len(fields) > 1:
+                raise AssetError(f"{path}:{number}: expected '<image>'")
+            images.append(os.path.join(base, fields[0]))
+    if not images:
+        raise AssetError(f"{path}: no images")
+    return images
+
+
+def pack_shelves(sizes, sheet_width, row_align):
+    """Shelf packing, tallest first. Shelves start at multiples of row_align.
+    Returns the (x, y) of each size, the used width and the sheet height."""
+    positions = [None] * len(sizes)
+    x = y = shelf_height = used_width = 0
+    for index in sorted(range(len(sizes)), key=lambda i: (-sizes[i][1], -sizes[i][0])):
+        width, height = sizes[index]
+        if x + width > sheet_width:
+            y += (shelf_height + row_align - 1) // row_align * row_align
+            x = shelf_height = 0
+        positions[index] = (x, y)
+        x += width
+        used_width = max(used_width, x)
+        shelf_height = max(shelf_height, height)
+    return positions, used_width, y + shelf_height
+
+
+def compile_atlas(args, fmt):
+    if fmt == FORMAT_PAGES_RLE:
+        raise AssetError(f"{args.source}: atlas sheets are not compressed, icons are cut out of them at any position")
+    paths = read_atlas_manifest(args.source)
+    icons = []
+    names = []
+    for path in paths:
+        width, height, pixels, opaque = read_image_with_mask(path, args)
+        if width > args.atlas_width:
+            raise AssetError(f"{path}: {width} pixels is wider than the {args.atlas_width} pixel sheet")
+        name = "".join(c if c.isalnum() else "_" for c in os.path.splitext(os.path.basename(path))[0]).upper()
+        if name in names:
+            raise AssetError(f"{path}: another icon is also called {name}")
+        icons.append((width, height, pixels, opaque))
+        names.append(name)
+
+    # Pages sheets keep each shelf on a page boundary, so unmasked icons are copied without shifting.
+    positions, sheet_width, sheet_height = pack_shelves([(i[0], i[1]) for i in icons], args.atlas_width, 8 if fmt == FORMAT_PAGES else 1)
+    if sheet_height > 255:
+        raise AssetError(f"{args.source}: the icons need a {sheet_width}x{sheet_height} sheet, above the 255 pixel height of bitmap_t")
+    sheet = [[0] * sheet_width for _ in range(sheet_height)]
+    mask = [[0] * sheet_width for _ in range(sheet_height)]
+    for (width, height, pixels, opaque), (x, y) in zip(icons, positions):
+        for row in range(height):
+            sheet[y + row][x:x + width] = pixels[row]
+            mask[y + row][x:x + width] = opaque[row]
+    has_mask = any(not all(row) for _, _, _, opaque in icons for row in opaque)
+
+    data = encode(sheet, sheet_width, fmt)
+    mask_data = encode(mask, sheet_width, fmt) if has_mask else b""
+    rects = "".join(f"    {{ {x}, {y}, {icon[0]}, {icon[1]} }}, // {name}\n" for icon, (x, y), name in zip(icons, positions, names))
+    body = f"static const uint8_t {args.name}_data[] = {{\n{c_bytes(data)}\n}};\n\n"
+    if has_mask:
+        body += f"static const uint8_t {args.name}_mask[] = {{\n{c_bytes(mask_data)}\n}};\n\n"
+    body += (f"static const bitmap_rect_t {args.name}_rects[] = {{\n{rects}}};\n\n"
+             f"const bitmap_atlas_t {args.name} = {{\n"
+             f"    .sheet = {{\n"
+             f"        .width = {sheet_width},\n"
+             f"        .height = {sheet_height},\n"
+             f"        .data = {args.name}_data,\n"
+             f"        .format = {FORMAT_NAMES[fmt]},\n"
+             f"    }},\n"
+             f"    .mask = {args.name + '_mask' if has_mask else 'NULL'},\n"
+             f"    .rects_count = {len(icons)},\n"
+             f"    .rects = {args.name}_rects,\n"
+             f"}};\n")
+    prefix = args.name.upper()
+    defines = "".join(f"#define {prefix}_{name} {index}\n" for index, name in enumerate(names)) + "\n"
+    write_outputs(args.out_dir, args.name, args.source, "bitmap.h", f"const bitmap_atlas_t {args.name}", body, defines)
+    return len(data) + len(mask_data) + 4 * len(icons)
+
+
+def collect_codepoints(args):
+    if args.chars is None and not args.chars_file:
+        return None
+    text = args.chars or ""
+    for path in args.chars_file:
+        with open(path, "r", encoding="utf-8") as f:
+            text += f.read()
+    return sorted({ord(c) for c in text if c.isprintable() and c != " "})
+
+
+def compile_font(args, fmt):
+    wanted = collect_codepoints(args)
+    ext = os.path.splitext(args.source)[1].lower()
+    if ext == ".bdf":
+        height, glyphs = read_bdf(args.source)
+    else:
+        height, glyphs = read_freetype(args.source, args.size, wanted)
+    if not 0 < height <= 255:
+        raise AssetError(f"{args.source}: font height {height} is outside 1-255")
+
+    space = glyphs.get(0x20)
+    # Space is drawn by advancing word_spacing, it needs no glyph.
+    available = sorted(c for c in glyphs if 0x20 < c <= MAX_CODEPOINT)
+    if wanted is not None:
+        missing = [c for c in wanted if c not in glyphs]
+        if missing:
+            print(f"{args.source}: no glyph for " + " ".join(f"U+{c:04X}" for c in missing), file=sys.stderr)
+        available = [c for c in available if c in set(wanted)]
+    if not available:
+        raise AssetError(f"{args.source}: no glyphs selected")
+
+    widths = [glyphs[c][0] for c in available]
+    if max(widths) > 255:
+        raise AssetError(f"{args.source}: glyph wider than 255 pixels")
+    monospaced = len(set(widths)) == 1
+
+    # Long runs of consecutive codepoints become contiguous subsets (glyph index = codepoint - start).
+    # The remaining glyphs share one sparse subset with a sorted codepoint index, placed last
+    # so lookups in the contiguous subsets are not shadowed by its wider start..end range.
+    runs = []
+    for codepoint in available:
+        if runs and runs[-1][-1] == codepoint - 1:
+            runs[-1].append(codepoint)
+        else:
+            runs.append([codepoint])
+    groups = [run for run in runs if len(run) >= CONTIGUOUS_RUN_MIN]
+    scattered = sorted(c for run in runs if len(run) < CONTIGUOUS_RUN_MIN for c in run)
+    if scattered:
+        groups.append(scattered)
+
+    body = ""
+    subsets = []
+    total = 0
+    for index, group in enumerate(groups):
+        sparse = group is scattered
+        symbols = bytearray()
+        offsets = []
+        for codepoint in group:
+            advance, pixels = glyphs[codepoint]
+            offsets.append(len(symbols))
+            symbols += encode(pixels, advance, fmt)
+        total += len(symbols) + 4 * len(offsets) + (0 if monospaced else len(group)) + (4 * len(group) if sparse else 0)
+        prefix = f"{args.name}_{index}"
+        body += f"static const uint8_t {prefix}_symbols[] = {{\n{c_bytes(symbols)}\n}};\n\n"
+        body += f"static const uint32_t {prefix}_offsets[] = {{\n{c_words(offsets)}\n}};\n\n"
+        if not monospaced:
+            body += f"static const uint8_t {prefix}_widths[] = {{\n{c_words([glyphs[c][0] for c in group], 16)}\n}};\n\n"
+        if sparse:
+            body += f"static const uint32_t {prefix}_codepoints[] = {{\n{c_words(group, 12)}\n}};\n\n"
+        subsets.append(
+            "    {\n"
+            f"        .start = {group[0]},\n"
+            f"        .end = {group[-1]},\n"
+            f"        .symbols_count = {len(group)},\n"
+            f"        .symbols = {prefix}_symbols,\n"
+            f"        .offsets = {prefix}_offsets,\n"
+            f"        .widths = {'NULL' if monospaced else prefix + '_widths'},\n"
+            f"        .codepoints = {prefix + '_codepoints' if sparse else 'NULL'},\n"
+            "    },\n")
+
+    word_spacing = args.word_spacing if args.word_spacing is not None else (space[0] if space else max(1, height // 4))
+    body += f"static const font_subset_t {args.name}_subsets[] = {{\n{''.join(subsets)}}};\n\n"
+    body += (f"const font_t {args.name} = {{\n"
+             f"    .width = {max(widths)},\n"
+             f"    .height = {height},\n"
+             f"    .letter_spacing = {args.letter_spacing},\n"
+             f"    .word_spacing = {word_spacing},\n"
+             f"    .subsets_count = {len(groups)},\n"
+             f"    .subsets = {args.name}_subsets,\n"
+             f"    .format = {FORMAT_NAMES[fmt]},\n"
+             f"}};\n")
+    write_outputs(args.out_dir, args.name, args.source, "font.h", f"const font_t {args.name}", body)
+    return total
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Compile fonts and images into pico-ssd1306 C assets.")
+    parser.add_argument("source", help="BDF, TTF or OTF font, PNG or PBM image, .anim animation or .atlas icon manifest")
+    parser.add_argument("--name", required=True, help="C identifier of the asset, also the output file name")
+    parser.add_argument("--out-dir", required=True, help="Directory for <name>.h and <name>.c")
+    parser.add_argument("--format", choices=("rows", "pages"), default="rows",
+                        help="rows: layout of the web tools; pages: page-native, copied without bit shuffling")
+    parser.add_argument("--rle", action="store_true", help="Compress page data with PackBits (implies --format pages)")
+    parser.add_argument("--size", type=int, help="Pixel height for TTF/OTF fonts")
+    parser.add_argument("--chars", help="Only include glyphs for these characters")
+    parser.add_argument("--chars-file", action="append", default=[],
+                        help="Only include glyphs for characters used in this UTF-8 file (repeatable)")
+    parser.add_argument("--letter-spacing", type=int, default=0, help="Pixels between glyphs (default 0, the advance includes the bearings)")
+    parser.add_argument("--word-spacing", type=int, help="Width of a space (default: advance of the font's space glyph)")
+    parser.add_argument("--threshold", type=int, default=128, help="Image luminance from which a pixel is on (default 128)")
+    parser.add_argument("--invert", action="store_true", help="Invert image pixels")
+    parser.add_argument("--frame-ms", type=int, default=0,
+                        help="Animation frame duration when the manifest gives none (default 0: as fast as the bus allows)")
+    parser.add_argument("--loop", action="store_true", help="Add the animation frame from the last back to the first frame")
+    parser.add_argument("--atlas-width", type=int, default=128, help="Widest atlas sheet in pixels (default 128)")
+    args = parser.parse_args(argv)
+
+    if not args.name.isidentifier():
+        parser.error(f"--name {args.name!r} is not a C identifier")
+    if not 0 <= args.frame_ms <= 0xFFFF:
+        parser.error("--frame-ms must be 0-65535")
+    if not 0 < args.atlas_width <= 255:
+        parser.error("--atlas-width must be 1-255")
+    fmt = FORMAT_PAGES_RLE if args.rle else (FORMAT_PAGES if args.format == "pages" else FORMAT_ROWS)
+
+    try:
+        ext = os.path.splitext(args.source)[1].lower()
+        if ext in (".png", ".pbm"):
+            size = compile_bitmap(args, fmt)
+        elif ext in (".bdf", ".ttf", ".otf"):
+            size = compile_font(args, fmt)
+        elif ext == ".anim":
+            compile_animation(args)
+            return 0
+        elif ext == ".atlas":
+            size = compile_atlas(args, fmt)
+        else:
+            raise AssetError(f"{args.source}: unknown asset type {ext!r}")
+    except (AssetError, OSError, zlib.error) as error:
+        print(f"ssd1306_assets: {error}", file=sys.stderr)
+        return 1
+
+    print(f"ssd1306_assets: {args.name} ({FORMAT_NAMES[fmt]}): {size} bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
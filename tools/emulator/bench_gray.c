@@ -0,0 +1,79 @@
+/**
+ * Host throughput benchmark of ssd1306_draw_gray(): full-frame conversions per second for each dithering method.
+ * Usage: ssd1306_gray_bench [--size 128x64|128x32] [--frames N]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hardware/i2c.h"
+
+#include "ssd1306.h"
+
+#define SSD1306_I2C_ADDRESS 0x3C
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char** argv) {
+    ssd1306_display_size_t display_size = SSD1306_DISPLAY_SIZE_128x64;
+    uint32_t frames = 20000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "128x32") == 0) {
+                display_size = SSD1306_DISPLAY_SIZE_128x32;
+            }
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [--size 128x64|128x32] [--frames N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // Only the framebuffer is used, no I2C traffic.
+    ssd1306_t ssd1306 = ssd1306_create(i2c0, SSD1306_I2C_ADDRESS, display_size);
+    if (ssd1306.buffer == NULL || frames == 0) {
+        fprintf(stderr, "Failed to create SSD1306\n");
+        return 1;
+    }
+
+    // Diagonal gradient with some noise, like a heatmap or a photo.
+    static uint8_t pixels[128 * 64];
+    srand(1);
+    for (uint16_t y = 0; y < ssd1306.height; y++) {
+        for (uint16_t x = 0; x < ssd1306.width; x++) {
+            const int value = (x * 255 / (ssd1306.width - 1) + y * 255 / (ssd1306.height - 1)) / 2 + rand() % 32 - 16;
+            pixels[y * ssd1306.width + x] = (uint8_t)(value < 0 ? 0 : (value > 255 ? 255 : value));
+        }
+    }
+
+    static const struct {
+        const char* name;
+        ssd1306_dither_t dither;
+    } methods[] = {
+        { "bayer", SSD1306_DITHER_BAYER },
+        { "floyd_steinberg", SSD1306_DITHER_FLOYD_STEINBERG },
+        { "atkinson", SSD1306_DITHER_ATKINSON },
+    };
+
+    printf("method,frames,us_per_frame,frames_per_s,mpixels_per_s\n");
+    for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); m++) {
+        const uint64_t begin = now_ns();
+        for (uint32_t f = 0; f < frames; f++) {
+            ssd1306_draw_gray(&ssd1306, pixels, ssd1306.width, ssd1306.width, ssd1306.height, 0, 0, methods[m].dither);
+        }
+        const double elapsed_s = (double)(now_ns() - begin) / 1e9;
+        const double pixels_total = (double)frames * ssd1306.width * ssd1306.height;
+        printf("%s,%u,%.2f,%.0f,%.1f\n", methods[m].name, frames, elapsed_s * 1e6 / frames, frames / elapsed_s, pixels_total / elapsed_s / 1e6);
+    }
+
+    ssd1306_destroy(&ssd1306);
+    return 0;
+}
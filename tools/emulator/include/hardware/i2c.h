@@ -0,0 +1,37 @@
+/**
+ * Host shim of the Pico SDK header, for building the library against the SSD1306 emulator.
+ * Writes are delivered to the emulator attached at the target address.
+*/
+
+#ifndef _HARDWARE_I2C_H
+#define _HARDWARE_I2C_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/error.h"
+
+#ifndef __uninitialized_ram
+#define __uninitialized_ram(group) group
+#endif
+
+typedef unsigned int uint;
+
+#define NUM_I2CS 2
+
+typedef struct i2c_inst {
+    uint index;
+    uint baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+uint i2c_init(i2c_inst_t* i2c, uint baudrate);
+uint i2c_get_index(i2c_inst_t* i2c);
+int i2c_write_timeout_us(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop, uint timeout_us);
+int i2c_read_timeout_us(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop, uint timeout_us);
+
+#endif
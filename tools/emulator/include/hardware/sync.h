@@ -0,0 +1,32 @@
+/**
+ * Host shim of the Pico SDK header, for building the library against the SSD1306 emulator
+*/
+
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+#define PICO_SPINLOCK_ID_STRIPED_FIRST 16
+#define NUM_SPIN_LOCKS 32
+
+typedef volatile uint32_t spin_lock_t;
+
+extern spin_lock_t spin_lock_host[NUM_SPIN_LOCKS];
+
+static inline spin_lock_t* spin_lock_instance(unsigned int lock_num) {
+    return &spin_lock_host[lock_num];
+}
+
+static inline uint32_t spin_lock_blocking(spin_lock_t* lock) {
+    while (__atomic_exchange_n(lock, 1u, __ATOMIC_ACQUIRE) != 0) {
+    }
+    return 0;
+}
+
+static inline void spin_unlock(spin_lock_t* lock, uint32_t saved_irq) {
+    (void)saved_irq;
+    __atomic_store_n(lock, 0u, __ATOMIC_RELEASE);
+}
+
+#endif
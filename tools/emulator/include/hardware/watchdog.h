@@ -0,0 +1,20 @@
+/**
+ * Host shim of the Pico SDK header, for building the library against the SSD1306 emulator
+*/
+
+#ifndef _HARDWARE_WATCHDOG_H
+#define _HARDWARE_WATCHDOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    volatile uint32_t scratch[8];
+} watchdog_hw_t;
+
+extern watchdog_hw_t watchdog_host;
+#define watchdog_hw (&watchdog_host)
+
+bool watchdog_caused_reboot(void);
+
+#endif
@@ -0,0 +1,16 @@
+/**
+ * Host shim of the Pico SDK header, for building the library against the SSD1306 emulator
+*/
+
+#ifndef _PICO_ERROR_H
+#define _PICO_ERROR_H
+
+enum pico_error_codes {
+    PICO_OK = 0,
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+    PICO_ERROR_NO_DATA = -3,
+};
+
+#endif
@@ -0,0 +1,13 @@
+/**
+ * Host shim of the Pico SDK header, for building the library against the SSD1306 emulator
+*/
+
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+#include "pico/error.h"
+#include "pico/time.h"
+
+#define tight_loop_contents() ((void)0)
+
+#endif
@@ -0,0 +1,15 @@
+/**
+ * Host shim of the Pico SDK header, for building the library against the SSD1306 emulator
+*/
+
+#ifndef _PICO_TIME_H
+#define _PICO_TIME_H
+
+#include <stdint.h>
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+#endif
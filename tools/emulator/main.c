@@ -0,0 +1,159 @@
+/**
+ * Render library output through the SSD1306 emulator and report bus cost per frame.
+ * Usage: ssd1306_emu [--size 128x64|128x32] [--clock HZ] [--out DIR]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#include "ssd1306.h"
+#include "ssd1306_sprite.h"
+#include "ssd1306_chart.h"
+#include "ssd1306_console.h"
+#include "ssd1306_emu.h"
+#include "raspberry_pi_logo.h"
+#include "google_sans_code_32.h"
+
+#define SSD1306_I2C_ADDRESS 0x3C
+
+static const char* out_dir = ".";
+
+static void report(ssd1306_emu_t* emu, const char* name) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.png", out_dir, name);
+    ssd1306_emu_write_png(emu, path, 4);
+    snprintf(path, sizeof(path), "%s/%s.pbm", out_dir, name);
+    ssd1306_emu_write_pbm(emu, path);
+
+    printf("%s,%u,%u,%u,%llu\n", name, emu->transfers, emu->command_bytes, emu->data_bytes,
+           (unsigned long long)(emu->bus_time_ns / 1000u));
+    ssd1306_emu_reset_bus_stats(emu);
+}
+
+int main(int argc, char** argv) {
+    ssd1306_display_size_t display_size = SSD1306_DISPLAY_SIZE_128x64;
+    uint8_t height = 64;
+    uint32_t clock_hz = 400 * 1000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "128x32") == 0) {
+                display_size = SSD1306_DISPLAY_SIZE_128x32;
+                height = 32;
+            }
+        } else if (strcmp(argv[i], "--clock") == 0 && i + 1 < argc) {
+            clock_hz = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--size 128x64|128x32] [--clock HZ] [--out DIR]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    ssd1306_emu_t emu;
+    ssd1306_emu_init(&emu, 128, height);
+    ssd1306_emu_attach(&emu, i2c0, SSD1306_I2C_ADDRESS);
+    const uint baudrate = i2c_init(i2c0, clock_hz);
+
+    ssd1306_t ssd1306 = ssd1306_create(i2c0, SSD1306_I2C_ADDRESS, display_size);
+    ssd1306_set_i2c_baudrate(&ssd1306, baudrate);
+    ssd1306_config_t ssd1306_cfg = ssd1306_get_default_config();
+    if (!ssd1306_init(&ssd1306, &ssd1306_cfg)) {
+        fprintf(stderr, "Failed to initialize SSD1306\n");
+        return 1;
+    }
+    ssd1306_set_font(&ssd1306, &google_sans_code_32);
+
+    printf("frame,transfers,command_bytes,data_bytes,bus_us\n");
+    report(&emu, "init");
+
+    ssd1306_print(&ssd1306, "128x64", 10, 0);
+    ssd1306_show(&ssd1306);
+    report(&emu, "text");
+
+    ssd1306_clear_display(&ssd1306);
+    ssd1306_draw_bitmap(&ssd1306, &raspberry_pi_logo, 0, 0);
+    ssd1306_show(&ssd1306);
+    report(&emu, "bitmap");
+
+    // A small change: only the 8x8 block at the top-left corner.
+    static const uint8_t block_data[] = { 0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF };
+    const bitmap_t block = { .width = 8, .height = 8, .data = block_data };
+    ssd1306_draw_bitmap(&ssd1306, &block, 0, 0);
+    ssd1306_show(&ssd1306);
+    report(&emu, "partial");
+
+    // A masked sprite moving over the logo: only the columns it left and entered are recomposed.
+    static const uint8_t ball_data[] = { 0x3C, 0x42, 0x81, 0x81, 0x81, 0x81, 0x42, 0x3C };
+    static const uint8_t ball_mask[] = { 0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C };
+    const bitmap_t ball = { .width = 8, .height = 8, .data = ball_data };
+    static uint8_t background[128 * 64 / SSD1306_BITS_PER_COLUMN];
+    memcpy(background, ssd1306.buffer + 1, (size_t)ssd1306.width * ssd1306.height / SSD1306_BITS_PER_COLUMN);
+    ssd1306_sprite_layer_t layer = ssd1306_sprite_layer_create(&ssd1306, background);
+    ssd1306_sprite_t sprite = ssd1306_sprite_create(&ball, ball_mask, 60, 10, 0);
+    ssd1306_sprite_layer_add(&layer, &sprite);
+    ssd1306_sprite_layer_compose(&layer);
+    ssd1306_show(&ssd1306);
+    ssd1306_emu_reset_bus_stats(&emu);
+    sprite.x += 3;
+    sprite.y += 2;
+    ssd1306_sprite_layer_compose(&layer);
+    ssd1306_show(&ssd1306);
+    report(&emu, "sprite");
+
+    // Horizontal grayscale ramp, dithered at runtime.
+    static uint8_t ramp[128 * 64];
+    for (uint16_t i = 0; i < sizeof(ramp); i++) {
+        ramp[i] = (uint8_t)((i % 128) * 2);
+    }
+    ssd1306_draw_gray(&ssd1306, ramp, 128, 128, height, 0, 0, SSD1306_DITHER_FLOYD_STEINBERG);
+    ssd1306_show(&ssd1306);
+    report(&emu, "gray");
+
+    // Strip chart: each sample scrolls the controller RAM by one column, then one column per page is sent.
+    ssd1306_chart_t chart = ssd1306_chart_create(&ssd1306, 0, 0, 128, height, -100, 100);
+    chart.hardware_scroll = true;
+    ssd1306_chart_clear(&chart);
+    for (int16_t i = 0; i < 128; i++) {
+        ssd1306_chart_push(&chart, (int16_t)((i % 32) * 6 - 90));
+    }
+    ssd1306_show(&ssd1306);
+    ssd1306_emu_reset_bus_stats(&emu);
+    sleep_us(SSD1306_CONTENT_SCROLL_INTERVAL_US);
+    ssd1306_chart_push(&chart, 90);
+    ssd1306_show(&ssd1306);
+    report(&emu, "chart");
+
+    // Console: a new line moves the display start line and sends only the cells that differ from the recycled row.
+    ssd1306_console_t console = ssd1306_console_create(&ssd1306, &google_sans_code_32);
+    ssd1306_console_clear(&console);
+    ssd1306_console_write(&console, "t=10\nt=11\n");
+    ssd1306_show(&ssd1306);
+    ssd1306_emu_reset_bus_stats(&emu);
+    ssd1306_console_write(&console, "t=12\n");
+    ssd1306_show(&ssd1306);
+    report(&emu, "console");
+    ssd1306_set_start_line(&ssd1306, 0);
+
+    // Portrait: a 64-column framebuffer, each changed 8x8 block is transposed while it is sent.
+    ssd1306_set_rotation(&ssd1306, SSD1306_ROTATION_90);
+    ssd1306_print(&ssd1306, "90", 0, 0);
+    ssd1306_show(&ssd1306);
+    report(&emu, "portrait");
+
+    ssd1306_set_inverse(&ssd1306, true);
+    report(&emu, "inverse");
+
+    if (emu.unknown_commands != 0) {
+        fprintf(stderr, "Unknown commands: %u\n", emu.unknown_commands);
+        return 1;
+    }
+
+    ssd1306_destroy(&ssd1306);
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * Host implementation of the Pico SDK functions used by the library.
+ * I2C transfers are routed to attached SSD1306 emulators.
+*/
+
+#include <time.h>
+#include "pico/time.h"
+#include "hardware/i2c.h"
+#include "hardware/sync.h"
+#include "hardware/watchdog.h"
+#include "ssd1306_emu.h"
+
+#define HOST_I2C_DEVICES_MAX 8
+
+typedef struct {
+    i2c_inst_t* i2c;
+    uint8_t address;
+    ssd1306_emu_t* emu;
+} host_i2c_device_t;
+
+i2c_inst_t i2c0_inst = { .index = 0, .baudrate = 100000 };
+i2c_inst_t i2c1_inst = { .index = 1, .baudrate = 100000 };
+watchdog_hw_t watchdog_host;
+spin_lock_t spin_lock_host[NUM_SPIN_LOCKS];
+
+static host_i2c_device_t host_i2c_devices[HOST_I2C_DEVICES_MAX];
+static uint8_t host_i2c_devices_count;
+
+static ssd1306_emu_t* host_i2c_find(i2c_inst_t* i2c, uint8_t address) {
+    for (uint8_t i = 0; i < host_i2c_devices_count; i++) {
+        if (host_i2c_devices[i].i2c == i2c && host_i2c_devices[i].address == address) {
+            return host_i2c_devices[i].emu;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Connect an emulator to a bus address. The emulator counts bus time at the bus baud rate.
+*/
+void ssd1306_emu_attach(ssd1306_emu_t* emu, i2c_inst_t* i2c, uint8_t address) {
+    if (host_i2c_devices_count < HOST_I2C_DEVICES_MAX) {
+        host_i2c_devices[host_i2c_devices_count++] = (host_i2c_device_t){ .i2c = i2c, .address = address, .emu = emu };
+    }
+    emu->clock_hz = i2c->baudrate;
+}
+
+uint i2c_init(i2c_inst_t* i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    for (uint8_t i = 0; i < host_i2c_devices_count; i++) {
+        if (host_i2c_devices[i].i2c == i2c) {
+            host_i2c_devices[i].emu->clock_hz = baudrate;
+        }
+    }
+    return baudrate;
+}
+
+uint i2c_get_index(i2c_inst_t* i2c) {
+    return i2c->index;
+}
+
+int i2c_write_timeout_us(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop, uint timeout_us) {
+    (void)nostop;
+    (void)timeout_us;
+    ssd1306_emu_t* emu = host_i2c_find(i2c, addr);
+    if (emu == NULL) {
+        return PICO_ERROR_GENERIC;
+    }
+    ssd1306_emu_write(emu, src, len);
+    return (int)len;
+}
+
+int i2c_read_timeout_us(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop, uint timeout_us) {
+    (void)nostop;
+    (void)timeout_us;
+    ssd1306_emu_t* emu = host_i2c_find(i2c, addr);
+    if (emu == NULL) {
+        return PICO_ERROR_GENERIC;
+    }
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = ssd1306_emu_read_status(emu);
+    }
+    return (int)len;
+}
+
+uint64_t time_us_64(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000u + (uint64_t)now.tv_nsec / 1000u;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+void sleep_us(uint64_t us) {
+    const struct timespec duration = { .tv_sec = (time_t)(us / 1000000u), .tv_nsec = (long)((us % 1000000u) * 1000u) };
+    nanosleep(&duration, NULL);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+bool watchdog_caused_reboot(void) {
+    return false;
+}
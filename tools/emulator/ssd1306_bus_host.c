@@ -0,0 +1,30 @@
+/**
+ * Host implementation of the non-blocking I2C writes (src/ssd1306_bus.c).
+ * The transfer is delivered to the emulator when it starts and finishes once its wire time at the
+ * bus baud rate has passed, so transfers on different buses overlap as they do on hardware.
+*/
+
+#include "pico/time.h"
+#include "hardware/i2c.h"
+#include "ssd1306_internal.h"
+
+void _ssd1306_bus_start(ssd1306_bus_transfer_t* transfer, i2c_inst_t* i2c_inst, uint8_t address, const uint8_t* data, size_t len, uint32_t timeout_us) {
+    *transfer = (ssd1306_bus_transfer_t){
+        .i2c_inst = i2c_inst,
+        .data = data,
+        .len = len,
+        .queued = len,
+        .result = i2c_write_timeout_us(i2c_inst, address, data, len, false, timeout_us),
+    };
+    // 9 clocks per byte including ACK, plus the address byte. A NAKed address ends after one byte.
+    const uint64_t bytes = transfer->result < 0 ? 1 : (uint64_t)len + 1;
+    transfer->deadline_us = time_us_64() + (bytes * 9 * 1000000u) / i2c_inst->baudrate;
+}
+
+bool _ssd1306_bus_poll(ssd1306_bus_transfer_t* transfer, int* result) {
+    if (time_us_64() < transfer->deadline_us) {
+        return false;
+    }
+    *result = transfer->result;
+    return true;
+}
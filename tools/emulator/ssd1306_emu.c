@@ -0,0 +1,444 @@
+/**
+ * SSD1306 controller emulator for host builds
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306_emu.h"
+
+// I2C control byte bits
+#define SSD1306_EMU_CONTROL_CONTINUATION 0x80 // Co: one byte follows, then another control byte
+#define SSD1306_EMU_CONTROL_DATA 0x40 // D/C#
+
+void ssd1306_emu_init(ssd1306_emu_t* emu, uint8_t width, uint8_t height) {
+    memset(emu, 0, sizeof(*emu));
+    emu->width = width;
+    emu->height = height;
+    emu->ram_columns = SSD1306_EMU_COLUMNS;
+
+    // Values after RESET, see the SSD1306 datasheet command tables.
+    emu->addressing_mode = 0x02;
+    emu->column_end = SSD1306_EMU_COLUMNS - 1;
+    emu->page_end = SSD1306_EMU_PAGES - 1;
+    emu->mux_ratio = SSD1306_EMU_ROWS - 1;
+    emu->contrast = 0x7F;
+    emu->clock_hz = 100000;
+}
+
+/**
+ * SH1106: 132-column RAM and a reduced command set. Commands it does not know are counted
+ * in unknown_commands, and their argument bytes are parsed as commands like on the chip.
+*/
+void ssd1306_emu_init_sh1106(ssd1306_emu_t* emu, uint8_t width, uint8_t height) {
+    ssd1306_emu_init(emu, width, height);
+    emu->sh1106 = true;
+    emu->ram_columns = SSD1306_EMU_RAM_COLUMNS_MAX;
+    emu->column_end = SSD1306_EMU_RAM_COLUMNS_MAX - 1;
+}
+
+void ssd1306_emu_reset_bus_stats(ssd1306_emu_t* emu) {
+    emu->bus_time_ns = 0;
+    emu->transfers = 0;
+    emu->command_bytes = 0;
+    emu->data_bytes = 0;
+}
+
+/**
+ * Bytes following the command byte
+*/
+static uint8_t ssd1306_emu_get_args_count(const ssd1306_emu_t* emu, uint8_t command) {
+    if (emu->sh1106) {
+        switch (command) {
+            case 0x81: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            case 0xAD: // DC-DC control
+                return 1;
+            default:
+                return 0;
+        }
+    }
+    switch (command) {
+        case 0x81: // Contrast
+        case 0x20: // Memory addressing mode
+        case 0xA8: // Multiplex ratio
+        case 0xD3: // Display offset
+        case 0xD5: // Clock divide
+        case 0xD9: // Pre-charge period
+        case 0xDA: // COM pins
+        case 0xDB: // VCOMH deselect level
+        case 0x8D: // Charge pump
+        case 0x23: // Fade out / blinking
+        case 0xD6: // Zoom in
+        case 0xFD: // Command lock (SSD1309)
+            return 1;
+        case 0x21: // Column address
+        case 0x22: // Page address
+        case 0xA3: // Vertical scroll area
+            return 2;
+        case 0x29: // Vertical and horizontal scroll
+        case 0x2A:
+            return 5;
+        case 0x26: // Horizontal scroll
+        case 0x27:
+        case 0x2C: // Content scroll by one column
+        case 0x2D:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * RAM cell a column address selects. Segment re-map (A1) mirrors the address when data is
+ * written, so it only affects data written after the command, like on the chip.
+*/
+static uint8_t ssd1306_emu_get_segment(const ssd1306_emu_t* emu, uint8_t column) {
+    column %= emu->ram_columns;
+    return emu->segment_remap ? (uint8_t)(emu->ram_columns - 1 - column) : column;
+}
+
+/**
+ * One-column content scroll: RAM columns [start_column, end_column] of pages [start_page, end_page]
+ * move by one column, the column pushed out of the window comes back in on the other side.
+*/
+static void ssd1306_emu_content_scroll(ssd1306_emu_t* emu, bool left, uint8_t start_page, uint8_t end_page, uint8_t start_column, uint8_t end_column) {
+    if (start_column >= end_column) {
+        return;
+    }
+    const size_t length = end_column - start_column;
+    for (uint8_t page = start_page; page <= end_page; page++) {
+        uint8_t* row = &emu->ram[page][start_column];
+        if (left) {
+            const uint8_t first = row[0];
+            memmove(row, row + 1, length);
+            row[length] = first;
+        } else {
+            const uint8_t last = row[length];
+            memmove(row + 1, row, length);
+            row[0] = last;
+        }
+    }
+}
+
+static void ssd1306_emu_execute(ssd1306_emu_t* emu) {
+    const uint8_t command = emu->command;
+    const uint8_t* args = emu->args;
+
+    if (command <= 0x0F) {
+        emu->page_mode_column_start = (emu->page_mode_column_start & 0xF0) | command;
+        emu->column = emu->page_mode_column_start;
+        return;
+    }
+    if (command <= 0x1F) {
+        const uint8_t high_mask = emu->sh1106 ? 0x0F : 0x07;
+        emu->page_mode_column_start = (uint8_t)(((command & high_mask) << 4) | (emu->page_mode_column_start & 0x0F));
+        emu->column = emu->page_mode_column_start;
+        return;
+    }
+    if (command >= 0x40 && command <= 0x7F) {
+        emu->start_line = command & 0x3F;
+        return;
+    }
+    if (command >= 0xB0 && command <= 0xB7) {
+        emu->page = command & 0x07;
+        return;
+    }
+    if (emu->sh1106) {
+        switch (command) {
+            case 0x81: emu->contrast = args[0]; break;
+            case 0xA0: emu->segment_remap = false; break;
+            case 0xA1: emu->segment_remap = true; break;
+            case 0xA4: emu->entire_on = false; break;
+            case 0xA5: emu->entire_on = true; break;
+            case 0xA6: emu->inverse = false; break;
+            case 0xA7: emu->inverse = true; break;
+            case 0xA8: emu->mux_ratio = args[0] & 0x3F; break;
+            case 0xAE: emu->display_on = false; break;
+            case 0xAF: emu->display_on = true; break;
+            case 0xC0: emu->com_remap = false; break;
+            case 0xC8: emu->com_remap = true; break;
+            case 0xD3: emu->display_offset = args[0] & 0x3F; break;
+            case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0xAD: case 0xE3: break;
+            default: emu->unknown_commands++; break;
+        }
+        return;
+    }
+
+    switch (command) {
+        case 0x81: emu->contrast = args[0]; break;
+        case 0x20: emu->addressing_mode = args[0] & 0x03; break;
+        case 0x21:
+            emu->column_start = args[0] & 0x7F;
+            emu->column_end = args[1] & 0x7F;
+            emu->column = emu->column_start;
+            break;
+        case 0x22:
+            emu->page_start = args[0] & 0x07;
+            emu->page_end = args[1] & 0x07;
+            emu->page = emu->page_start;
+            break;
+        case 0xA0: emu->segment_remap = false; break;
+        case 0xA1: emu->segment_remap = true; break;
+        case 0xA4: emu->entire_on = false; break;
+        case 0xA5: emu->entire_on = true; break;
+        case 0xA6: emu->inverse = false; break;
+        case 0xA7: emu->inverse = true; break;
+        case 0xA8: emu->mux_ratio = args[0] & 0x3F; break;
+        case 0xAE: emu->display_on = false; break;
+        case 0xAF: emu->display_on = true; break;
+        case 0xC0: emu->com_remap = false; break;
+        case 0xC8: emu->com_remap = true; break;
+        case 0xD3: emu->display_offset = args[0] & 0x3F; break;
+        // Timing, power, scrolling and graphic effects do not change the picture model.
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB: case 0x8D: case 0x23: case 0xD6: case 0xFD:
+        case 0x26: case 0x27: case 0x29: case 0x2A: case 0xA3:
+        case 0x2E: case 0x2F: case 0xE3:
+            break;
+        case 0x2C: case 0x2D:
+            if (emu->segment_remap) {
+                // Mirrored window, and the content moves the other way through RAM.
+                ssd1306_emu_content_scroll(emu, command != 0x2D, args[1] & 0x07, args[3] & 0x07, ssd1306_emu_get_segment(emu, args[5] & 0x7F), ssd1306_emu_get_segment(emu, args[4] & 0x7F));
+            } else {
+                ssd1306_emu_content_scroll(emu, command == 0x2D, args[1] & 0x07, args[3] & 0x07, args[4] & 0x7F, args[5] & 0x7F);
+            }
+            break;
+        default:
+            emu->unknown_commands++;
+            break;
+    }
+}
+
+static void ssd1306_emu_command_byte(ssd1306_emu_t* emu, uint8_t value) {
+    if (emu->args_count < emu->args_needed) {
+        emu->args[emu->args_count++] = value;
+    } else {
+        emu->command = value;
+        emu->args_needed = ssd1306_emu_get_args_count(emu, value);
+        emu->args_count = 0;
+    }
+    if (emu->args_count == emu->args_needed) {
+        ssd1306_emu_execute(emu);
+    }
+}
+
+/**
+ * Store one byte at the address pointer and advance it like the controller does in each addressing mode
+*/
+static void ssd1306_emu_data_byte(ssd1306_emu_t* emu, uint8_t value) {
+    emu->ram[emu->page & 0x07][ssd1306_emu_get_segment(emu, emu->column)] = value;
+
+    switch (emu->addressing_mode) {
+        case 0x00: // Horizontal
+            if (emu->column >= emu->column_end) {
+                emu->column = emu->column_start;
+                emu->page = (emu->page >= emu->page_end) ? emu->page_start : emu->page + 1;
+            } else {
+                emu->column++;
+            }
+            break;
+        case 0x01: // Vertical
+            if (emu->page >= emu->page_end) {
+                emu->page = emu->page_start;
+                emu->column = (emu->column >= emu->column_end) ? emu->column_start : emu->column + 1;
+            } else {
+                emu->page++;
+            }
+            break;
+        default: // Page: the pointer wraps inside the page
+            emu->column = (emu->column >= emu->ram_columns - 1) ? emu->page_mode_column_start : emu->column + 1;
+            break;
+    }
+}
+
+/**
+ * Consume one I2C write transfer (bytes after the slave address)
+*/
+void ssd1306_emu_write(ssd1306_emu_t* emu, const uint8_t* data, size_t len) {
+    // START + address byte + payload, 9 clocks per byte with ACK, STOP
+    const uint64_t bits = 1 + ((uint64_t)len + 1) * 9 + 1;
+    emu->bus_time_ns += (bits * 1000000000ull) / emu->clock_hz;
+    emu->transfers++;
+
+    size_t i = 0;
+    while (i < len) {
+        const uint8_t control = data[i++];
+        const bool is_data = (control & SSD1306_EMU_CONTROL_DATA) != 0;
+        const bool is_single = (control & SSD1306_EMU_CONTROL_CONTINUATION) != 0;
+        const size_t end = is_single ? ((i < len) ? i + 1 : i) : len;
+        for (; i < end; i++) {
+            if (is_data) {
+                emu->data_bytes++;
+                ssd1306_emu_data_byte(emu, data[i]);
+            } else {
+                emu->command_bytes++;
+                ssd1306_emu_command_byte(emu, data[i]);
+            }
+        }
+    }
+}
+
+/**
+ * Status byte returned by an I2C read: bit 6 is set while the display is OFF
+*/
+uint8_t ssd1306_emu_read_status(const ssd1306_emu_t* emu) {
+    return emu->display_on ? 0x00 : 0x40;
+}
+
+/**
+ * Visible pixel of the panel.
+ * The glass is mounted like common modules: with segment re-map (A1) and remapped
+ * COM scan (C8) the RAM appears upright, column 0 on the left and row 0 on top.
+ * COM scan direction applies to the output at once, segment re-map was applied when
+ * the data was written.
+*/
+bool ssd1306_emu_get_pixel(const ssd1306_emu_t* emu, uint8_t x, uint8_t y) {
+    if (x >= emu->width || y >= emu->height || !emu->display_on) {
+        return false;
+    }
+    if (emu->entire_on) {
+        return true;
+    }
+
+    const uint8_t rows = emu->mux_ratio + 1;
+    if (y >= rows) {
+        return false; // COM line not driven
+    }
+
+    const uint8_t com = emu->com_remap ? y : (uint8_t)(rows - 1 - y);
+    const uint8_t row = (uint8_t)((com + emu->start_line + emu->display_offset) % SSD1306_EMU_ROWS);
+    const uint8_t margin = (emu->ram_columns - SSD1306_EMU_COLUMNS) / 2;
+    const uint8_t segment = margin + (uint8_t)(SSD1306_EMU_COLUMNS - 1 - x);
+    const bool bit = ((emu->ram[row / 8][segment] >> (row % 8)) & 1u) != 0;
+    return bit != emu->inverse;
+}
+
+bool ssd1306_emu_write_pbm(const ssd1306_emu_t* emu, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    fprintf(file, "P4\n%u %u\n", emu->width, emu->height);
+    for (uint8_t y = 0; y < emu->height; y++) {
+        uint8_t row[SSD1306_EMU_COLUMNS / 8] = {0};
+        for (uint8_t x = 0; x < emu->width; x++) {
+            if (ssd1306_emu_get_pixel(emu, x, y)) {
+                row[x / 8] |= (uint8_t)(0x80 >> (x % 8));
+            }
+        }
+        fwrite(row, 1, (emu->width + 7) / 8, file);
+    }
+
+    return fclose(file) == 0;
+}
+
+static uint32_t ssd1306_emu_crc32(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static void ssd1306_emu_put_u32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+}
+
+static void ssd1306_emu_write_png_chunk(FILE* file, const char* type, const uint8_t* data, uint32_t len) {
+    uint8_t header[8];
+    ssd1306_emu_put_u32(header, len);
+    memcpy(&header[4], type, 4);
+    fwrite(header, 1, sizeof(header), file);
+    if (len > 0) {
+        fwrite(data, 1, len, file);
+    }
+
+    uint8_t crc[4];
+    ssd1306_emu_put_u32(crc, ssd1306_emu_crc32(ssd1306_emu_crc32(0, (const uint8_t*)type, 4), data, len));
+    fwrite(crc, 1, sizeof(crc), file);
+}
+
+/**
+ * 8-bit grayscale PNG, each pixel drawn as a scale x scale square.
+ * The image data uses stored (uncompressed) deflate blocks, so no zlib is needed.
+*/
+bool ssd1306_emu_write_png(const ssd1306_emu_t* emu, const char* path, uint8_t scale) {
+    if (scale == 0) {
+        scale = 1;
+    }
+    const uint32_t width = (uint32_t)emu->width * scale;
+    const uint32_t height = (uint32_t)emu->height * scale;
+    const uint32_t raw_len = (width + 1) * height; // Filter byte per row
+
+    // Worst case: 128x64 at scale 8 is ~0.5 MB of raw pixels, plus 5 bytes per 64 KB block.
+    const uint32_t blocks = (raw_len + 65534) / 65535;
+    const uint32_t zlib_len = 2 + raw_len + blocks * 5 + 4;
+    uint8_t* zlib = (uint8_t*)malloc(zlib_len);
+    if (zlib == NULL) {
+        return false;
+    }
+
+    uint32_t out = 0;
+    zlib[out++] = 0x78; // Deflate, 32K window
+    zlib[out++] = 0x01; // No preset dictionary, header checksum
+
+    uint32_t adler_a = 1;
+    uint32_t adler_b = 0;
+    uint32_t raw_pos = 0;
+    uint32_t block_left = 0;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x <= width; x++) {
+            if (block_left == 0) {
+                block_left = (raw_len - raw_pos > 65535) ? 65535 : (raw_len - raw_pos);
+                zlib[out++] = (raw_pos + block_left == raw_len) ? 0x01 : 0x00; // BFINAL, BTYPE = stored
+                zlib[out++] = (uint8_t)block_left;
+                zlib[out++] = (uint8_t)(block_left >> 8);
+                zlib[out++] = (uint8_t)~block_left;
+                zlib[out++] = (uint8_t)(~block_left >> 8);
+            }
+            uint8_t value = 0; // Filter type None at x == 0
+            if (x > 0) {
+                value = ssd1306_emu_get_pixel(emu, (uint8_t)((x - 1) / scale), (uint8_t)(y / scale)) ? 0xFF : 0x00;
+            }
+            zlib[out++] = value;
+            adler_a = (adler_a + value) % 65521;
+            adler_b = (adler_b + adler_a) % 65521;
+            raw_pos++;
+            block_left--;
+        }
+    }
+    ssd1306_emu_put_u32(&zlib[out], (adler_b << 16) | adler_a);
+    out += 4;
+
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        free(zlib);
+        return false;
+    }
+
+    static const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    fwrite(signature, 1, sizeof(signature), file);
+
+    uint8_t ihdr[13];
+    ssd1306_emu_put_u32(&ihdr[0], width);
+    ssd1306_emu_put_u32(&ihdr[4], height);
+    ihdr[8] = 8; // Bit depth
+    ihdr[9] = 0; // Grayscale
+    ihdr[10] = 0; // Deflate
+    ihdr[11] = 0; // Adaptive filtering
+    ihdr[12] = 0; // No interlace
+    ssd1306_emu_write_png_chunk(file, "IHDR", ihdr, sizeof(ihdr));
+    ssd1306_emu_write_png_chunk(file, "IDAT", zlib, out);
+    ssd1306_emu_write_png_chunk(file, "IEND", NULL, 0);
+
+    free(zlib);
+    return fclose(file) == 0;
+}
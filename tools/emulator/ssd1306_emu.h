@@ -0,0 +1,77 @@
+/**
+ * SSD1306 controller emulator for host builds
+ * Author: Pavel Koltyshev
+ * (c) 2025
+*/
+
+#ifndef SSD1306_EMU_H
+#define SSD1306_EMU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+
+#define SSD1306_EMU_COLUMNS 128
+#define SSD1306_EMU_RAM_COLUMNS_MAX 132 // SH1106
+#define SSD1306_EMU_ROWS 64
+#define SSD1306_EMU_PAGES 8
+#define SSD1306_EMU_MAX_ARGS 7
+
+typedef struct {
+    // Panel glass
+    uint8_t width;
+    uint8_t height;
+
+    // Graphic display data RAM; the panel shows the middle SSD1306_EMU_COLUMNS columns
+    bool sh1106; // SH1106 command set: page addressing only, no charge pump, fade or zoom
+    uint8_t ram_columns;
+    uint8_t ram[SSD1306_EMU_PAGES][SSD1306_EMU_RAM_COLUMNS_MAX]; // By segment: with segment re-map, column c was stored at ram_columns - 1 - c
+
+    // Addressing
+    uint8_t addressing_mode;
+    uint8_t column_start;
+    uint8_t column_end;
+    uint8_t page_start;
+    uint8_t page_end;
+    uint8_t page_mode_column_start;
+    uint8_t column;
+    uint8_t page;
+
+    // Hardware configuration
+    bool segment_remap;
+    bool com_remap;
+    uint8_t start_line;
+    uint8_t display_offset;
+    uint8_t mux_ratio;
+    uint8_t contrast;
+    bool inverse;
+    bool entire_on;
+    bool display_on;
+
+    // Command parser
+    uint8_t command;
+    uint8_t args[SSD1306_EMU_MAX_ARGS];
+    uint8_t args_needed;
+    uint8_t args_count;
+    uint32_t unknown_commands;
+
+    // Bus accounting
+    uint32_t clock_hz;
+    uint64_t bus_time_ns;
+    uint32_t transfers;
+    uint32_t command_bytes;
+    uint32_t data_bytes;
+} ssd1306_emu_t;
+
+void ssd1306_emu_init(ssd1306_emu_t* emu, uint8_t width, uint8_t height);
+void ssd1306_emu_init_sh1106(ssd1306_emu_t* emu, uint8_t width, uint8_t height);
+void ssd1306_emu_attach(ssd1306_emu_t* emu, i2c_inst_t* i2c, uint8_t address);
+void ssd1306_emu_write(ssd1306_emu_t* emu, const uint8_t* data, size_t len);
+uint8_t ssd1306_emu_read_status(const ssd1306_emu_t* emu);
+bool ssd1306_emu_get_pixel(const ssd1306_emu_t* emu, uint8_t x, uint8_t y);
+void ssd1306_emu_reset_bus_stats(ssd1306_emu_t* emu);
+bool ssd1306_emu_write_pbm(const ssd1306_emu_t* emu, const char* path);
+bool ssd1306_emu_write_png(const ssd1306_emu_t* emu, const char* path, uint8_t scale);
+
+#endif // SSD1306_EMU_H